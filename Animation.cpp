@@ -0,0 +1,231 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "Animation.h"
+#include "Container.h"
+
+#include <algorithm>
+#include <iostream>
+
+// Maximum number of time steps per update. Prevents the animations from falling further behind after a long frame
+static constexpr int maxStepsPerUpdate = 8;
+
+// ___________________________________________________________________________
+Animator::Animator() {
+    // Default to 60 time steps per second
+    timeStep_ = sf::seconds(1.f / 60);
+}
+
+// ___________________________________________________________________________
+void Animator::setTimeStep(sf::Time timeStep) {
+    if (timeStep <= sf::Time::Zero) {
+        std::cerr << "Animator time step has to be positive. Keeping the previous time step." << std::endl;
+        return;
+    }
+
+    timeStep_ = timeStep;
+}
+
+// ___________________________________________________________________________
+void Animator::setMinimumFrameInterval(sf::Time frameInterval) {
+    minimumFrameInterval_ = std::max(frameInterval, sf::Time::Zero);
+}
+
+// ___________________________________________________________________________
+void Animator::animateOffset(Container &container, sf::Vector2f from, sf::Vector2f to, sf::Time duration,
+                             Easing easing, sf::Time frameInterval) {
+    addTween(container, Property::Offset, {from.x, from.y, 0, 0}, {to.x, to.y, 0, 0}, duration, easing, frameInterval);
+}
+
+// ___________________________________________________________________________
+void Animator::animateScale(Container &container, sf::Vector2f from, sf::Vector2f to, sf::Time duration,
+                            Easing easing, sf::Time frameInterval) {
+    addTween(container, Property::Scale, {from.x, from.y, 0, 0}, {to.x, to.y, 0, 0}, duration, easing, frameInterval);
+}
+
+// ___________________________________________________________________________
+void Animator::animateBackgroundColor(Container &container, sf::Color from, sf::Color to, sf::Time duration,
+                                      Easing easing, sf::Time frameInterval) {
+    addTween(container, Property::BackgroundColor,
+             {static_cast<float>(from.r), static_cast<float>(from.g), static_cast<float>(from.b), static_cast<float>(from.a)},
+             {static_cast<float>(to.r), static_cast<float>(to.g), static_cast<float>(to.b), static_cast<float>(to.a)},
+             duration, easing, frameInterval);
+}
+
+// ___________________________________________________________________________
+void Animator::animateOpacity(Container &container, float from, float to, sf::Time duration, Easing easing,
+                              sf::Time frameInterval) {
+    addTween(container, Property::Opacity, {from, 0, 0, 0}, {to, 0, 0, 0}, duration, easing, frameInterval);
+}
+
+// ___________________________________________________________________________
+void Animator::stopAnimations(Container &container) {
+    // A container without animation state has never been animated, so there is nothing to stop
+    AnimationState* state = container.animationState_.get();
+    if (!state) {
+        return;
+    }
+
+    // Remove all tweens referencing the container's animation state. The container keeps the current color
+    tweens_.erase(std::remove_if(tweens_.begin(), tweens_.end(),
+                                 [state](const Tween& tween) { return tween.state.get() == state; }),
+                  tweens_.end());
+    state->backgroundColorTweenCount = 0;
+    container.takeAnimatedBackground();
+    container.releaseAnimationState();
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Accumulate the elapsed time and simulate it in fixed time steps
+ * - Finished tweens and tweens of destroyed containers are swapped with the last tween and popped, so removing
+ * them doesn't shift the remaining tweens
+ * - Once the last background color tween of a container has finished, the container takes over the color. Once its
+ * last tween has finished, the container releases its animation state if the animations ended at the default values
+ */
+// ___________________________________________________________________________
+void Animator::update(sf::Time elapsed) {
+    // Don't accumulate time while idle. Otherwise, the next animation would start with a jump
+    if (tweens_.empty()) {
+        accumulator_ = sf::Time::Zero;
+        return;
+    }
+
+    accumulator_ += elapsed;
+
+    int steps = 0;
+    while (accumulator_ >= timeStep_ and steps < maxStepsPerUpdate) {
+        accumulator_ -= timeStep_;
+        steps++;
+
+        size_t index = 0;
+        while (index < tweens_.size()) {
+            if (stepTween(tweens_[index])) {
+                AnimationState& state = *tweens_[index].state;
+                Container* owner = state.isAttached ? state.owner : nullptr;
+                bool isLastColorTween = tweens_[index].property == Property::BackgroundColor and
+                                        --state.backgroundColorTweenCount == 0;
+                if (index + 1 != tweens_.size()) {
+                    tweens_[index] = std::move(tweens_.back());
+                }
+                tweens_.pop_back();
+                if (owner) {
+                    if (isLastColorTween) {
+                        owner->takeAnimatedBackground();
+                    }
+                    owner->releaseAnimationState();
+                }
+            } else {
+                index++;
+            }
+        }
+    }
+
+    // Drop the time that couldn't be simulated in this update
+    if (steps == maxStepsPerUpdate) {
+        accumulator_ = sf::Time::Zero;
+    }
+}
+
+// ___________________________________________________________________________
+bool Animator::isIdle() const {
+    return tweens_.empty();
+}
+
+// ___________________________________________________________________________
+size_t Animator::getAnimationCount() const {
+    return tweens_.size();
+}
+
+// ___________________________________________________________________________
+void Animator::addTween(Container &container, Animator::Property property, const float (&from)[4],
+                        const float (&to)[4], sf::Time duration, Easing easing, sf::Time frameInterval) {
+    Tween tween{container.getAnimationState(), property, easing, {}, {}, duration, sf::Time::Zero, frameInterval,
+                sf::Time::Zero};
+    std::copy(std::begin(from), std::end(from), tween.from);
+    std::copy(std::begin(to), std::end(to), tween.to);
+    if (property == Property::BackgroundColor) {
+        tween.state->backgroundColorTweenCount++;
+    }
+
+    // Apply the start values immediately, so that the first frame already shows them
+    applyTween(tween);
+    tweens_.push_back(std::move(tween));
+}
+
+// ___________________________________________________________________________
+bool Animator::stepTween(Animator::Tween &tween) {
+    // Drop tweens whose container has been destroyed
+    if (!tween.state->isAttached) {
+        return true;
+    }
+
+    tween.elapsed += timeStep_;
+    tween.sinceLastFrame += timeStep_;
+    bool hasFinished = tween.elapsed >= tween.duration;
+
+    // Only apply the tween when its own frame interval has passed. The last frame is always applied
+    if (tween.sinceLastFrame >= std::max(tween.frameInterval, minimumFrameInterval_) or hasFinished) {
+        tween.sinceLastFrame = sf::Time::Zero;
+        applyTween(tween);
+    }
+
+    return hasFinished;
+}
+
+// ___________________________________________________________________________
+void Animator::applyTween(Animator::Tween &tween) {
+    float progress = 1;
+    if (tween.duration > sf::Time::Zero) {
+        progress = std::min(1.f, tween.elapsed / tween.duration);
+    }
+    progress = ease(tween.easing, progress);
+
+    // Interpolate all four values. The end values are applied exactly, so that tweens back to the defaults end at them
+    float values[4];
+    for (size_t index = 0; index < 4; index++) {
+        values[index] = progress >= 1 ? tween.to[index]
+                                      : tween.from[index] + (tween.to[index] - tween.from[index]) * progress;
+    }
+
+    AnimationState& state = *tween.state;
+    switch (tween.property) {
+        case Property::Offset:
+            state.offset = sf::Vector2f(values[0], values[1]);
+            break;
+        case Property::Scale:
+            state.scale = sf::Vector2f(values[0], values[1]);
+            break;
+        case Property::BackgroundColor:
+            state.backgroundColor = sf::Color(static_cast<sf::Uint8>(values[0]), static_cast<sf::Uint8>(values[1]),
+                                              static_cast<sf::Uint8>(values[2]), static_cast<sf::Uint8>(values[3]));
+            state.hasBackgroundColor = true;
+            break;
+        case Property::Opacity:
+            state.opacity = std::clamp(values[0], 0.f, 1.f);
+            break;
+    }
+
+    // Cached layers containing the container have to be redrawn. The container's own layer already contains the
+    // background, so it only has to be redrawn for color changes. Offset, scale, and opacity are applied to its quad.
+    if (state.isAttached and state.owner) {
+        state.owner->invalidateLayers(tween.property == Property::BackgroundColor);
+    }
+}
+
+// ___________________________________________________________________________
+float Animator::ease(Easing easing, float progress) {
+    switch (easing) {
+        case Easing::Linear:
+            return progress;
+        case Easing::EaseIn:
+            return progress * progress;
+        case Easing::EaseOut:
+            return progress * (2 - progress);
+        case Easing::EaseInOut:
+            return progress < 0.5f ? 2 * progress * progress : -1 + (4 - 2 * progress) * progress;
+    }
+    return progress;
+}
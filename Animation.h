@@ -0,0 +1,129 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_ANIMATION_H
+#define SWIFTIFYSFML_V0_1_ANIMATION_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+#include "Enumerations.h"
+
+// Forward declaration of the container class
+class Container;
+
+/*
+ * AnimationState struct. Stores the animated properties of a container. These are applied at draw time, so animating
+ * them never triggers a layout update. The state is shared between the container and its running animations, which
+ * allows the animations to notice when the container has been destroyed. The container releases the state once its
+ * animations have ended at the default values.
+ */
+struct AnimationState {
+    // Translation and scale applied as render state transform. The scale is relative to the container's center
+    sf::Vector2f offset = sf::Vector2f(0, 0);
+    sf::Vector2f scale = sf::Vector2f(1, 1);
+
+    // Opacity of the container's background and outline. Applies to the whole container if it is cached as a layer
+    float opacity = 1;
+
+    // Animated background color. Only used if hasBackgroundColor is set. Once the last of the running background color
+    // tweens ends, the container takes over the color and the flag is reset
+    sf::Color backgroundColor;
+    bool hasBackgroundColor = false;
+    size_t backgroundColorTweenCount = 0;
+
+    // Flag indicating if the container still exists. Reset by the container's destructor
+    bool isAttached = true;
+
+    // Container the state belongs to. Used to invalidate cached layers. Only valid while the state is attached
+    Container* owner = nullptr;
+};
+
+/*
+ * Animator class. Runs tweens on a fixed time step. The tweens are stored in a flat vector and are removed once
+ * finished or once their container has been destroyed, so that thousands of them stay cheap to update.
+ */
+class Animator {
+public:
+    // Constructor and destructor
+    Animator();
+    ~Animator() = default;
+
+    // Set the fixed time step of the scheduler
+    void setTimeStep(sf::Time timeStep);
+
+    // Set the shortest frame interval of all tweens, e.g., to apply the animations less often under load. Tweens with a
+    // longer frame interval keep theirs. Zero restores the frame intervals of the tweens
+    void setMinimumFrameInterval(sf::Time frameInterval);
+
+    // Start tweens over the animatable properties of a container. The frame interval paces the individual animation.
+    // A frame interval of zero applies the tween on every time step.
+    void animateOffset(Container& container, sf::Vector2f from, sf::Vector2f to, sf::Time duration,
+                       Easing easing = Easing::Linear, sf::Time frameInterval = sf::Time::Zero);
+    void animateScale(Container& container, sf::Vector2f from, sf::Vector2f to, sf::Time duration,
+                      Easing easing = Easing::Linear, sf::Time frameInterval = sf::Time::Zero);
+    void animateBackgroundColor(Container& container, sf::Color from, sf::Color to, sf::Time duration,
+                                Easing easing = Easing::Linear, sf::Time frameInterval = sf::Time::Zero);
+    void animateOpacity(Container& container, float from, float to, sf::Time duration,
+                        Easing easing = Easing::Linear, sf::Time frameInterval = sf::Time::Zero);
+
+    // Stop all animations of a container. The animated properties keep their current values
+    void stopAnimations(Container& container);
+
+    // Advance the animations by the elapsed time in fixed time steps
+    void update(sf::Time elapsed);
+
+    // Returns true if no animation is running
+    [[nodiscard]] bool isIdle() const;
+
+    // Get the number of running animations
+    [[nodiscard]] size_t getAnimationCount() const;
+
+private:
+    // Animatable properties
+    enum class Property {
+        Offset,
+        Scale,
+        BackgroundColor,
+        Opacity
+    };
+
+    // Tween data. Start and end values are stored as four floats to handle all properties the same way
+    struct Tween {
+        std::shared_ptr<AnimationState> state;
+        Property property;
+        Easing easing;
+        float from[4];
+        float to[4];
+        sf::Time duration;
+        sf::Time elapsed;
+        sf::Time frameInterval;
+        sf::Time sinceLastFrame;
+    };
+
+    // Add a tween to the list of running tweens
+    void addTween(Container& container, Property property, const float (&from)[4], const float (&to)[4],
+                  sf::Time duration, Easing easing, sf::Time frameInterval);
+
+    // Advance a tween by one time step. Returns true if the tween has finished
+    bool stepTween(Tween& tween);
+
+    // Write the interpolated values of a tween to its animation state
+    static void applyTween(Tween& tween);
+
+    // Map the linear progress to the eased progress
+    static float ease(Easing easing, float progress);
+
+    // Running tweens
+    std::vector<Tween> tweens_;
+
+    // Fixed time step and the time that hasn't been simulated yet
+    sf::Time timeStep_;
+    sf::Time accumulator_;
+
+    // Shortest frame interval of all tweens
+    sf::Time minimumFrameInterval_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_ANIMATION_H
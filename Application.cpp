@@ -3,10 +3,17 @@
 //
 
 #include "Application.h"
+#include <algorithm>
 #include <iostream>
 
-Application::Application(sf::RenderWindow& window) : window_(window) {
-    currentScreen_ = nullptr;
+Application::Application(sf::RenderWindow& window) {
+    windows_.push_back(std::make_unique<ApplicationWindow>(*this, window));
+
+    // Animations are the first optional work to give up under load. They keep their duration, but are only applied
+    // 20 times per second
+    framePacer_.addDegradation("Animations", [this](bool isDegraded) {
+        animator_.setMinimumFrameInterval(isDegraded ? sf::seconds(1.f / 20) : sf::Time::Zero);
+    });
 }
 
 std::shared_ptr<Application> Application::getPtr() {
@@ -15,97 +22,310 @@ std::shared_ptr<Application> Application::getPtr() {
 
 void Application::run() {
     // Raise a warning if no screen has been set as the start screen.
-    if (!currentScreen_ or !*currentScreen_) {
+    if (!getCurrentScreen()) {
         std::cerr << "No screen is set as the start screen" << std::endl;
         exit(1);
     }
 
-    // Implement a basic main loop.
-    while (window_.isOpen()) {
-        sf::Event event;
-        while (window_.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                window_.close();
+    // Clock measuring the time between frames for the animations
+    sf::Clock frameClock;
+
+    // Only the events of the main window are recorded
+    std::function<void(const sf::Event&)> recordEvent = [this](const sf::Event& event) {
+        if (recorder_.isRecording()) {
+            recorder_.recordEvent(event);
+        }
+    };
+
+    auto isAnyWindowOpen = [this]() {
+        return std::any_of(windows_.begin(), windows_.end(),
+                           [](auto& window) { return window->getRenderWindow().isOpen(); });
+    };
+
+    // Implement a basic main loop. All windows are run by the same loop until they are closed
+    bool isDrawNeeded = true;
+    while (isAnyWindowOpen()) {
+        framePacer_.beginFrame();
+
+        // Collect all pending events of each window and dispatch the coalesced batches once
+        for (auto& window: windows_) {
+            if (window->pollEvents(window == windows_.front() ? recordEvent : nullptr)) {
+                isDrawNeeded = true;
+            }
+        }
+        for (auto& window: windows_) {
+            ApplicationWindow& eventWindow = *window;
+            window->dispatchEvents([this, &eventWindow](sf::Event& event) { handleEvent(eventWindow, event); });
+        }
+
+        // Continuations and bindings may modify any screen, including one being prewarmed on a worker thread
+        if (taskScheduler_.hasPendingTasks() or !changeSet_.isEmpty()) {
+            for (auto& window: windows_) {
+                window->waitForPrewarming();
+            }
+        }
+
+        // Resume the background tasks that finished since the last frame. Their changes are applied together with the
+        // ones of the events
+        if (taskScheduler_.resumeFinished() > 0) {
+            isDrawNeeded = true;
+        }
+
+        // Apply the model changes of the frame at once
+        if (!changeSet_.isEmpty()) {
+            isDrawNeeded = true;
+            changeSet_.apply();
+        }
+        framePacer_.endDispatch();
+
+        // Advance the animations and the transitions. They are paced individually, while the frame rate is limited by
+        // the display or the frame pacer
+        sf::Time elapsed = frameClock.restart();
+        if (recorder_.isRecording()) {
+            recorder_.recordFrame(elapsed);
+        }
+        advanceFrame(elapsed);
+        framePacer_.endUpdate();
+
+        // Draw all windows before presenting any, so that waiting for the display isn't counted as drawing. Only
+        // drawn frames are paced and accounted
+        if (isDrawNeeded) {
+            for (auto& window: windows_) {
+                sf::RenderWindow& renderWindow = window->getRenderWindow();
+                if (renderWindow.isOpen()) {
+                    renderWindow.clear();
+                    window->draw(renderWindow);
+                }
             }
-            (*currentScreen_)->handleEvent(event);
+            framePacer_.endDraw();
 
+            for (auto& window: windows_) {
+                if (window->getRenderWindow().isOpen()) {
+                    window->getRenderWindow().display();
+                }
+            }
+            framePacer_.endFrame();
         }
 
-        window_.clear();
-        (*currentScreen_)->draw(window_);
-        window_.display();
+        // Don't redraw unchanged windows while nothing is animating. A single window blocks until its next event,
+        // which is dispatched together with the ones following it in the next iteration. Several windows can't be
+        // waited for at once, and running background tasks have to be resumed without an event, so their events are
+        // polled in short intervals instead
+        isDrawNeeded = not isIdle();
+        if (not isDrawNeeded) {
+            sf::Event event;
+            if (windows_.size() > 1 or taskScheduler_.hasPendingTasks()) {
+                sf::sleep(sf::milliseconds(10));
+            } else if (windows_.front()->getRenderWindow().waitEvent(event)) {
+                recordEvent(event);
+                windows_.front()->getInputQueue().push(event);
+                isDrawNeeded = true;
+            }
+
+            // Don't count the idle time as animation time
+            frameClock.restart();
+        }
     }
 
 }
 
-void Application::transitionToScreen(const std::string &name) {
-    // Check the screens for a screen matching the given name. When found, set it. Else, raise an error
-    int checkStatus = checkIfNameExists(name);
+ApplicationWindow &Application::addWindow(sf::RenderWindow &window) {
+    windows_.push_back(std::make_unique<ApplicationWindow>(*this, window));
+    return *windows_.back();
+}
 
-    if (checkStatus > 0) {
-        std::cerr << "Screen '" << name << "' was not found. Couldn't transition." << std::endl;
-    } else {
-        currentScreen_ = &(screens_[checkStatus]);
+ApplicationWindow &Application::getMainWindow() {
+    return *windows_.front();
+}
+
+ApplicationWindow &Application::getWindow(size_t index) {
+    if (index >= windows_.size()) {
+        throw std::runtime_error("Window index " + std::to_string(index) + " is out of range.");
     }
+    return *windows_[index];
 }
 
-void Application::addScreen(std::unique_ptr<Screen> screen) {
-    // Add the screen to screens. Raise an error if a screen with that name already exists
-    std::string name = screen->getName();
-    int checkStatus = checkIfNameExists(name);
+size_t Application::getWindowCount() const {
+    return windows_.size();
+}
 
-    if (checkStatus > 0) {
-        std::cerr << "Screen '" << name << "' already exist. Please use a different name." << std::endl;
-    } else {
-        // Set the shared application pointer and add the screen to the list of screens
-        screen->setApplication(getPtr());
-        screens_.emplace_back(std::move(screen));
+AssetCache &Application::getAssets() {
+    return assets_;
+}
+
+ChangeSet &Application::getChangeSet() {
+    return changeSet_;
+}
+
+TaskScheduler &Application::getTaskScheduler() {
+    return taskScheduler_;
+}
 
-        // Set the first added screen as the start screen as a default
-        if (screens_.size() == 1) {
-            currentScreen_ = &screens_.back();
+FramePacer &Application::getFramePacer() {
+    return framePacer_;
+}
+
+bool Application::startRecording(const std::string &path) {
+    return recorder_.start(path, getMainWindow().getRenderWindow().getSize());
+}
+
+void Application::stopRecording() {
+    recorder_.stop();
+}
+
+ReplayReport Application::replay(const std::string &path) {
+    ReplayReport report;
+    ApplicationWindow& mainWindow = getMainWindow();
+
+    SessionReader reader;
+    if (!getCurrentScreen() or !reader.open(path)) {
+        std::cerr << "Couldn't replay session log '" << path << "'." << std::endl;
+        return report;
+    }
+
+    // Draw offscreen in the size of the recorded window, so that the replay neither waits for the display nor
+    // depends on the live window
+    sf::RenderTexture target;
+    sf::Vector2u windowSize = reader.getWindowSize();
+    if (!target.create(windowSize.x, windowSize.y)) {
+        std::cerr << "Couldn't create the replay texture." << std::endl;
+        return report;
+    }
+
+    auto eventHandler = [this, &mainWindow](sf::Event& event) { handleEvent(mainWindow, event); };
+    std::vector<sf::Event> events;
+    sf::Time elapsed;
+    sf::Clock phaseClock;
+
+    // Run the frames in the same order as the main loop, using the recorded frame times instead of the clock. The
+    // events have been recorded from the main window, so only its screens are replayed
+    while (reader.readFrame(events, elapsed)) {
+        FrameTiming timing;
+        timing.events = events.size();
+
+        phaseClock.restart();
+        for (auto& event: events) {
+            // Logs don't contain window management events, but one replayed by mistake mustn't close the live window
+            if (event.type != sf::Event::Closed and event.type != sf::Event::LostFocus and
+                event.type != sf::Event::GainedFocus) {
+                mainWindow.getInputQueue().push(event);
+            }
+        }
+        mainWindow.dispatchEvents(eventHandler);
+        if (taskScheduler_.hasPendingTasks() or !changeSet_.isEmpty()) {
+            mainWindow.waitForPrewarming();
         }
+        taskScheduler_.resumeFinished();
+        changeSet_.apply();
+        timing.dispatch = phaseClock.restart();
+
+        // The layout is computed separately from drawing, so that both can be told apart
+        advanceFrame(elapsed);
+        mainWindow.prewarm();
+        timing.layout = phaseClock.restart();
+
+        Container::resetBatchStatistics();
+        target.clear();
+        mainWindow.draw(target);
+        target.display();
+        timing.draw = phaseClock.restart();
+        timing.uploadedBytes = Container::getBatchStatistics().uploadedBytes;
+
+        report.frames.push_back(timing);
     }
 
+    return report;
+}
+
+void Application::printMemoryReport(std::ostream &stream) {
+    MemoryReport total;
+    for (auto& window: windows_) {
+        for (auto& screen: window->getScreens()) {
+            MemoryReport report = screen->getMemoryReport();
+            stream << "Screen '" << screen->getName() << "':" << std::endl;
+            report.print(stream);
+            total += report;
+        }
+    }
+
+    // Cached layers count against a limit shared by all screens. Assets are loaded once for all windows
+    stream << "All screens:" << std::endl;
+    total.print(stream);
+    stream << "Layer memory: " << Container::getLayerMemoryUsage() << " of " << Container::getLayerMemoryLimit()
+           << " bytes" << std::endl;
+    stream << "Shared textures: " << assets_.getMemoryUsage() << " bytes" << std::endl;
+}
+
+void Application::advanceFrame(sf::Time elapsed) {
+    animator_.update(elapsed);
+
+    // Advance the screen transitions and switch the current screens once they have finished
+    for (auto& window: windows_) {
+        window->advance(elapsed);
+    }
+}
+
+bool Application::isIdle() const {
+    return animator_.isIdle() and changeSet_.isEmpty() and
+           std::none_of(windows_.begin(), windows_.end(), [](auto& window) { return window->isTransitioning(); });
+}
+
+void Application::handleEvent(ApplicationWindow &window, sf::Event &event) {
+    window.handleEvent(event);
+}
+
+void Application::transitionToScreen(const std::string &name) {
+    getMainWindow().transitionToScreen(name);
+}
+
+void Application::transitionToScreen(const std::string &name, TransitionType type, sf::Time duration) {
+    getMainWindow().transitionToScreen(name, type, duration);
+}
 
+void Application::transitionToScreen(ScreenHandle screen, TransitionType type, sf::Time duration) {
+    getMainWindow().transitionToScreen(screen, type, duration);
+}
+
+ScreenHandle Application::addScreen(std::unique_ptr<Screen> screen) {
+    return getMainWindow().addScreen(std::move(screen));
 }
 
 void Application::removeScreen(const std::string &name) {
-    // Check if a screen with that name exists. If it does, remove it. Else raise an error
+    getMainWindow().removeScreen(name);
 }
 
-Screen& Application::getScreen(const std::string &name) {
-    int checkStatus = checkIfNameExists(name);
+void Application::removeScreen(ScreenHandle screen) {
+    getMainWindow().removeScreen(screen);
+}
 
-    if (checkStatus > 0) {
-        std::cerr << "Screen '" << name << "' was not found. Couldn't return it." << std::endl;
-    } else {
-        return *screens_[checkStatus];
-    }
+ScreenHandle Application::findScreen(const std::string &name) {
+    return getMainWindow().findScreen(name);
+}
 
-    // Should probably throw an error here
+Screen& Application::getScreen(const std::string &name) {
+    return getMainWindow().getScreen(name);
+}
+
+Screen &Application::getScreen(ScreenHandle screen) {
+    return getMainWindow().getScreen(screen);
 }
 
 void Application::setStartScreen(const std::string &name) {
-    int checkStatus = checkIfNameExists(name);
+    getMainWindow().setStartScreen(name);
+}
 
-    if (checkStatus > 0) {
-        std::cerr << "Screen '" << name << "' was not found. Couldn't set it as a start screen." << std::endl;
-    } else {
-        currentScreen_ = &(screens_[checkStatus]);
-    }
+void Application::setStartScreen(ScreenHandle screen) {
+    getMainWindow().setStartScreen(screen);
 }
 
-int Application::checkIfNameExists(const std::string& name) {
-    int index = 0;
+Animator &Application::getAnimator() {
+    return animator_;
+}
 
-    // Do the check and increment the index
-    for (auto& screen: screens_) {
-        if (screen->getName() == name) {
-            return index;
-        }
-        index++;
-    }
+InputQueue &Application::getInputQueue() {
+    return getMainWindow().getInputQueue();
+}
 
-    return -1;
+Screen *Application::getCurrentScreen() {
+    return getMainWindow().getCurrentScreen();
 }
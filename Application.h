@@ -8,6 +8,13 @@
 #include <memory>
 #include <vector>
 #include "Screen.h"
+#include "Animation.h"
+#include "ApplicationWindow.h"
+#include "AssetCache.h"
+#include "SessionLog.h"
+#include "Binding.h"
+#include "TaskScheduler.h"
+#include "FramePacer.h"
 
 // Forward declaration of the screen class
 // class Screen;
@@ -15,6 +22,10 @@
 /*
  * Abstract Application class. Handles high-level functionalities and interactions such as screen transitions and
  * running the main loop. It can be subclassed and extended with additional functionalities.
+ *
+ * An application can drive several windows, e.g., one per display. Each window has its own screens, while the
+ * animator, the change set and the assets are shared, and a single main loop runs all windows. The screen functions
+ * of the application refer to the main window, which is the one passed to the constructor.
  */
 class Application : public std::enable_shared_from_this<Application> {
 public:
@@ -24,36 +35,110 @@ public:
 
     std::shared_ptr<Application> getPtr();
 
-    // Run the main loop of the application
+    // Run the main loop of the application until all windows are closed
     virtual void run();
 
-    // Transition to a new screen via the screen's name by updating the current screen
+    // Add another window with its own screens. The window has to outlive the application. Vertical synchronization
+    // should only be enabled on one window, since every window waits for its display otherwise
+    ApplicationWindow& addWindow(sf::RenderWindow& window);
+
+    // Get the main window or any window by index. The main window has index 0
+    ApplicationWindow& getMainWindow();
+    ApplicationWindow& getWindow(size_t index);
+    [[nodiscard]] size_t getWindowCount() const;
+
+    // Get a reference to the assets shared by all screens and windows
+    AssetCache& getAssets();
+
+    // Transition to a new screen via the screen's name or handle by updating the current screen. The screen is
+    // prepared on a worker thread first and shown once it is ready, optionally with a visual transition
     virtual void transitionToScreen(const std::string& name);
+    virtual void transitionToScreen(const std::string& name, TransitionType type, sf::Time duration);
+    virtual void transitionToScreen(ScreenHandle screen, TransitionType type, sf::Time duration);
 
-    // Add a new screen
-    virtual void addScreen(std::unique_ptr<Screen> screen);
+    // Add a new screen. Returns its handle, which is invalid if the screen couldn't be added
+    virtual ScreenHandle addScreen(std::unique_ptr<Screen> screen);
 
-    // Remove a screen (is this necessary?)
+    // Remove a screen. The current screen and a screen that is being transitioned to can't be removed
     virtual void removeScreen(const std::string& name);
+    virtual void removeScreen(ScreenHandle screen);
 
-    // Get a reference to a screen by name
+    // Get the handle of a screen by name. The handle is invalid if no screen with that name exists
+    ScreenHandle findScreen(const std::string& name);
+
+    // Get a reference to a screen by name or handle. Throws if the screen doesn't exist
     Screen& getScreen(const std::string& name);
+    Screen& getScreen(ScreenHandle screen);
 
     // Set the current screen to the specified startScreen
     void setStartScreen(const std::string& name);
+    void setStartScreen(ScreenHandle screen);
+
+    // Get a reference to the animator that runs the animations in the main loop
+    Animator& getAnimator();
+
+    // Get a reference to the input queue of the main window. Provides the event counters and input latencies
+    InputQueue& getInputQueue();
+
+    // Get a reference to the change set of the observables. It's applied once per frame after the events have been
+    // dispatched, before the layout is computed
+    ChangeSet& getChangeSet();
+
+    // Get a reference to the scheduler of the background tasks. Their continuations are resumed once per frame after
+    // the events have been dispatched, before the change set is applied
+    TaskScheduler& getTaskScheduler();
+
+    // Get a reference to the frame pacer. It measures the drawn frames against the target frame time and degrades
+    // optional work under load. Slower animations are registered as the first degradation
+    FramePacer& getFramePacer();
+
+    // Record the events of the main window and the frame times of the main loop to a binary log. Returns false if the
+    // log couldn't be opened
+    bool startRecording(const std::string& path);
+    void stopRecording();
+
+    // Replay a recorded session at maximum speed without presenting anything. The screens are drawn into an offscreen
+    // texture of the recorded window's size. The screens have to be set up as they were when the recording started.
+    // Returns the dispatch, layout and draw time and the uploaded vertex bytes of every frame
+    ReplayReport replay(const std::string& path);
+
+    // Print the memory report of every screen and their sum, followed by the shared assets
+    void printMemoryReport(std::ostream& stream);
 
 protected:
-    // Check if a screen with a given name exists. Returns the index if it does. Else returns -1.
-    int checkIfNameExists(const std::string& name);
+    // Handle a single event of a window by passing it to the window's current screen
+    virtual void handleEvent(ApplicationWindow& window, sf::Event& event);
+
+    // Advance the animations and the screen transitions of all windows by the elapsed time
+    void advanceFrame(sf::Time elapsed);
+
+    // Returns true if nothing is animating, no window is transitioning and no change is pending
+    [[nodiscard]] bool isIdle() const;
+
+    // Get the current screen of the main window. Returns nullptr if no screen is set
+    Screen* getCurrentScreen();
+
+    // Windows of the application. The first one is the main window
+    std::vector<std::unique_ptr<ApplicationWindow>> windows_;
+
+    // Runs the animations of all windows on a fixed time step
+    Animator animator_;
+
+    // Collects the changes of the observables during a frame
+    ChangeSet changeSet_;
+
+    // Fonts and textures shared by all windows
+    AssetCache assets_;
 
-    // Window for drawing graphics
-    sf::RenderWindow& window_;
+    // Writes the session to a log while recording
+    SessionRecorder recorder_;
 
-    // Store the screens in the application
-    std::vector<std::unique_ptr<Screen>> screens_;
+    // Paces the drawn frames and degrades optional work under load
+    FramePacer framePacer_;
 
-    // Pointer to the current screen pointer
-    std::unique_ptr<Screen>* currentScreen_;
+    // Runs background tasks and resumes them in the main loop. Declared last, so that the workers stop before the
+    // rest of the application is destroyed
+    TaskScheduler taskScheduler_;
 };
 
 #endif //SWIFTIFYSFML_V0_1_APPLICATION_H
@@ -0,0 +1,225 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "ApplicationWindow.h"
+#include "Application.h"
+#include <algorithm>
+#include <iostream>
+
+ApplicationWindow::ApplicationWindow(Application &application, sf::RenderWindow &window)
+: application_(application), window_(window) {}
+
+void ApplicationWindow::transitionToScreen(const std::string &name) {
+    transitionToScreen(name, TransitionType::None, sf::Time::Zero);
+}
+
+void ApplicationWindow::transitionToScreen(const std::string &name, TransitionType type, sf::Time duration) {
+    ScreenHandle screen = findScreen(name);
+
+    if (!Screen::resolve(screen)) {
+        std::cerr << "Screen '" << name << "' was not found. Couldn't transition." << std::endl;
+    } else {
+        transitionToScreen(screen, type, duration);
+    }
+}
+
+void ApplicationWindow::transitionToScreen(ScreenHandle screen, TransitionType type, sf::Time duration) {
+    // Resolve the screen. When found, start the transition. Else, raise an error
+    Screen* targetScreen = Screen::resolve(screen);
+    Screen* currentScreen = getCurrentScreen();
+
+    if (!targetScreen) {
+        std::cerr << "Screen handle doesn't refer to a screen. Couldn't transition." << std::endl;
+    } else if (transition_.isActive()) {
+        std::cerr << "A screen transition is already in progress. Couldn't transition to '"
+                  << targetScreen->getName() << "'." << std::endl;
+    } else if (!currentScreen or currentScreen == targetScreen) {
+        // Nothing to transition from
+        currentScreen_ = screen;
+    } else {
+        transition_.start(*currentScreen, *targetScreen, type, duration);
+    }
+}
+
+ScreenHandle ApplicationWindow::addScreen(std::unique_ptr<Screen> screen) {
+    // Add the screen to screens. Raise an error if a screen with that name already exists
+    std::string name = screen->getName();
+    int checkStatus = checkIfNameExists(name);
+
+    if (checkStatus >= 0) {
+        std::cerr << "Screen '" << name << "' already exist. Please use a different name." << std::endl;
+        return {};
+    }
+
+    // Set the shared application pointer and add the screen to the list of screens
+    ScreenHandle handle = screen->getHandle();
+    screen->setApplication(application_.getPtr());
+    screens_.emplace_back(std::move(screen));
+
+    // Set the first added screen as the start screen as a default
+    if (screens_.size() == 1) {
+        currentScreen_ = handle;
+    }
+
+    return handle;
+}
+
+void ApplicationWindow::removeScreen(const std::string &name) {
+    // Check if a screen with that name exists. If it does, remove it. Else raise an error
+    ScreenHandle screen = findScreen(name);
+
+    if (!Screen::resolve(screen)) {
+        std::cerr << "Screen '" << name << "' was not found. Couldn't remove it." << std::endl;
+    } else {
+        removeScreen(screen);
+    }
+}
+
+void ApplicationWindow::removeScreen(ScreenHandle screen) {
+    Screen* screenToRemove = Screen::resolve(screen);
+    auto ownedScreen = std::find_if(screens_.begin(), screens_.end(),
+                                    [screenToRemove](auto& ownedScreen) { return ownedScreen.get() == screenToRemove; });
+
+    if (!screenToRemove or ownedScreen == screens_.end()) {
+        std::cerr << "Screen handle doesn't refer to a screen of this window. Couldn't remove it." << std::endl;
+    } else if (screenToRemove == getCurrentScreen() or
+               (transition_.isActive() and screenToRemove == transition_.getTargetScreen())) {
+        std::cerr << "Screen '" << screenToRemove->getName() << "' is in use. Couldn't remove it." << std::endl;
+    } else {
+        // Destroying the screen invalidates all handles to it
+        screens_.erase(ownedScreen);
+    }
+}
+
+ScreenHandle ApplicationWindow::findScreen(const std::string &name) {
+    int checkStatus = checkIfNameExists(name);
+
+    if (checkStatus < 0) {
+        return {};
+    }
+    return screens_[checkStatus]->getHandle();
+}
+
+Screen& ApplicationWindow::getScreen(const std::string &name) {
+    ScreenHandle screen = findScreen(name);
+
+    if (!Screen::resolve(screen)) {
+        throw std::runtime_error("Screen '" + name + "' was not found. Couldn't return it.");
+    }
+    return getScreen(screen);
+}
+
+Screen &ApplicationWindow::getScreen(ScreenHandle screen) {
+    Screen* resolvedScreen = Screen::resolve(screen);
+
+    if (!resolvedScreen) {
+        throw std::runtime_error("Screen handle doesn't refer to a screen. Couldn't return it.");
+    }
+    return *resolvedScreen;
+}
+
+void ApplicationWindow::setStartScreen(const std::string &name) {
+    ScreenHandle screen = findScreen(name);
+
+    if (!Screen::resolve(screen)) {
+        std::cerr << "Screen '" << name << "' was not found. Couldn't set it as a start screen." << std::endl;
+    } else {
+        setStartScreen(screen);
+    }
+}
+
+void ApplicationWindow::setStartScreen(ScreenHandle screen) {
+    if (!Screen::resolve(screen)) {
+        std::cerr << "Screen handle doesn't refer to a screen. Couldn't set it as a start screen." << std::endl;
+    } else {
+        currentScreen_ = screen;
+    }
+}
+
+Screen *ApplicationWindow::getCurrentScreen() {
+    return Screen::resolve(currentScreen_);
+}
+
+const std::vector<std::unique_ptr<Screen>> &ApplicationWindow::getScreens() const {
+    return screens_;
+}
+
+sf::RenderWindow &ApplicationWindow::getRenderWindow() {
+    return window_;
+}
+
+InputQueue &ApplicationWindow::getInputQueue() {
+    return inputQueue_;
+}
+
+bool ApplicationWindow::pollEvents(const std::function<void(const sf::Event &)> &onEvent) {
+    bool hasEvents = false;
+    sf::Event event;
+    while (window_.pollEvent(event)) {
+        if (onEvent) {
+            onEvent(event);
+        }
+        inputQueue_.push(event);
+        hasEvents = true;
+    }
+    return hasEvents;
+}
+
+void ApplicationWindow::dispatchEvents(const std::function<void(sf::Event &)> &handler) {
+    inputQueue_.dispatch(handler);
+}
+
+void ApplicationWindow::handleEvent(sf::Event &event) {
+    if (event.type == sf::Event::Closed) {
+        window_.close();
+    }
+
+    // Screens don't receive input while a transition is in progress
+    if (!transition_.isActive() and getCurrentScreen()) {
+        getCurrentScreen()->handleEvent(event);
+    }
+}
+
+void ApplicationWindow::advance(sf::Time elapsed) {
+    // Switch the current screen once the transition has finished
+    if (transition_.isActive() and transition_.update(elapsed, window_.getSize())) {
+        currentScreen_ = transition_.getTargetScreen()->getHandle();
+    }
+}
+
+bool ApplicationWindow::isTransitioning() const {
+    return transition_.isActive();
+}
+
+void ApplicationWindow::prewarm() {
+    if (!transition_.isActive() and getCurrentScreen()) {
+        getCurrentScreen()->prewarm();
+    }
+}
+
+void ApplicationWindow::waitForPrewarming() {
+    transition_.waitForPrewarming();
+}
+
+void ApplicationWindow::draw(sf::RenderTarget &target) {
+    if (transition_.isActive()) {
+        transition_.draw(target);
+    } else if (getCurrentScreen()) {
+        getCurrentScreen()->draw(target);
+    }
+}
+
+int ApplicationWindow::checkIfNameExists(const std::string& name) {
+    int index = 0;
+
+    // Do the check and increment the index
+    for (auto& screen: screens_) {
+        if (screen->getName() == name) {
+            return index;
+        }
+        index++;
+    }
+
+    return -1;
+}
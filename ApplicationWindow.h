@@ -0,0 +1,116 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_APPLICATIONWINDOW_H
+#define SWIFTIFYSFML_V0_1_APPLICATIONWINDOW_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Screen.h"
+#include "InputQueue.h"
+#include "ScreenTransition.h"
+
+// Forward declaration of the application class
+class Application;
+
+/*
+ * ApplicationWindow class. One window of an application with its own screens, current screen, input queue and screen
+ * transition. The application runs all of its windows from a single main loop and shares the animator, the change
+ * set and the assets between them. Screen names only have to be unique within a window.
+ */
+class ApplicationWindow {
+public:
+    // Constructor and destructor. The window has to outlive the application window
+    ApplicationWindow(Application& application, sf::RenderWindow& window);
+    ~ApplicationWindow() = default;
+
+    // Delete copy constructor and copy assignment operator. Screens refer to the window
+    ApplicationWindow(const ApplicationWindow&) = delete;
+    ApplicationWindow& operator=(const ApplicationWindow&) = delete;
+
+    // Transition to a new screen via the screen's name or handle by updating the current screen. The screen is
+    // prepared on a worker thread first and shown once it is ready, optionally with a visual transition
+    void transitionToScreen(const std::string& name);
+    void transitionToScreen(const std::string& name, TransitionType type, sf::Time duration);
+    void transitionToScreen(ScreenHandle screen, TransitionType type, sf::Time duration);
+
+    // Add a new screen. Returns its handle, which is invalid if the screen couldn't be added
+    ScreenHandle addScreen(std::unique_ptr<Screen> screen);
+
+    // Remove a screen. The current screen and a screen that is being transitioned to can't be removed
+    void removeScreen(const std::string& name);
+    void removeScreen(ScreenHandle screen);
+
+    // Get the handle of a screen by name. The handle is invalid if no screen with that name exists
+    ScreenHandle findScreen(const std::string& name);
+
+    // Get a reference to a screen by name or handle. Throws if the screen doesn't exist
+    Screen& getScreen(const std::string& name);
+    Screen& getScreen(ScreenHandle screen);
+
+    // Set the current screen to the specified startScreen
+    void setStartScreen(const std::string& name);
+    void setStartScreen(ScreenHandle screen);
+
+    // Get the current screen. Returns nullptr if no screen is set
+    Screen* getCurrentScreen();
+
+    // Get all screens of the window
+    [[nodiscard]] const std::vector<std::unique_ptr<Screen>>& getScreens() const;
+
+    // Get the render window and the input queue of this window
+    sf::RenderWindow& getRenderWindow();
+    InputQueue& getInputQueue();
+
+    // --- Main loop steps. Called by the application ---
+
+    // Move the pending events of the window into the input queue. Returns true if there were any
+    bool pollEvents(const std::function<void(const sf::Event&)>& onEvent);
+
+    // Dispatch the queued events with the handler
+    void dispatchEvents(const std::function<void(sf::Event&)>& handler);
+
+    // Route an event to the current screen. Closes the window on a close event
+    void handleEvent(sf::Event& event);
+
+    // Advance the screen transition by the elapsed time
+    void advance(sf::Time elapsed);
+
+    // Returns true if a screen transition is in progress
+    [[nodiscard]] bool isTransitioning() const;
+
+    // Compute the pending layout of the current screen without drawing it
+    void prewarm();
+
+    // Block until the screen being transitioned to has been prewarmed, so that it can be modified
+    void waitForPrewarming();
+
+    // Draw the screen transition or the current screen
+    void draw(sf::RenderTarget& target);
+
+private:
+    // Check if a screen with a given name exists. Returns the index if it does. Else returns -1.
+    int checkIfNameExists(const std::string& name);
+
+    // Application owning this window
+    Application& application_;
+
+    // Window for drawing graphics
+    sf::RenderWindow& window_;
+
+    // Store the screens of this window
+    std::vector<std::unique_ptr<Screen>> screens_;
+
+    // Handle to the current screen. Stays valid when screens are added or removed
+    ScreenHandle currentScreen_;
+
+    // Collects and coalesces the events of a frame
+    InputQueue inputQueue_;
+
+    // Transition to the next screen, if one is in progress
+    ScreenTransition transition_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_APPLICATIONWINDOW_H
@@ -0,0 +1,57 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "AssetCache.h"
+
+#include <iostream>
+
+// ___________________________________________________________________________
+std::shared_ptr<sf::Font> AssetCache::getFont(const std::string &path) {
+    auto& font = fonts_[path];
+    if (!font) {
+        auto loadedFont = std::make_shared<sf::Font>();
+        if (!loadedFont->loadFromFile(path)) {
+            std::cerr << "Couldn't load font '" << path << "'." << std::endl;
+            fonts_.erase(path);
+            return nullptr;
+        }
+        font = std::move(loadedFont);
+    }
+    return font;
+}
+
+// ___________________________________________________________________________
+std::shared_ptr<sf::Texture> AssetCache::getTexture(const std::string &path) {
+    auto& texture = textures_[path];
+    if (!texture) {
+        auto loadedTexture = std::make_shared<sf::Texture>();
+        if (!loadedTexture->loadFromFile(path)) {
+            std::cerr << "Couldn't load texture '" << path << "'." << std::endl;
+            textures_.erase(path);
+            return nullptr;
+        }
+        texture = std::move(loadedTexture);
+    }
+    return texture;
+}
+
+// ___________________________________________________________________________
+void AssetCache::releaseUnused() {
+    // The cache holds the only reference of unused assets
+    for (auto font = fonts_.begin(); font != fonts_.end();) {
+        font = font->second.use_count() == 1 ? fonts_.erase(font) : std::next(font);
+    }
+    for (auto texture = textures_.begin(); texture != textures_.end();) {
+        texture = texture->second.use_count() == 1 ? textures_.erase(texture) : std::next(texture);
+    }
+}
+
+// ___________________________________________________________________________
+size_t AssetCache::getMemoryUsage() const {
+    size_t memoryUsage = 0;
+    for (auto& [path, texture]: textures_) {
+        memoryUsage += static_cast<size_t>(texture->getSize().x) * texture->getSize().y * 4;
+    }
+    return memoryUsage;
+}
@@ -0,0 +1,41 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_ASSETCACHE_H
+#define SWIFTIFYSFML_V0_1_ASSETCACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/*
+ * AssetCache class. Loads fonts and textures once per file and shares them between all screens and windows of an
+ * application. SFML shares the OpenGL resources between the contexts of all windows, so a texture or the glyph
+ * atlas of a font can be used in every window. Assets stay loaded while any user holds them and until they are
+ * released. Not thread-safe, so assets should be loaded on the main thread.
+ */
+class AssetCache {
+public:
+    // Constructor and destructor
+    AssetCache() = default;
+    ~AssetCache() = default;
+
+    // Get the font or texture loaded from the file. Loads it on first use. Returns nullptr if it couldn't be loaded
+    std::shared_ptr<sf::Font> getFont(const std::string& path);
+    std::shared_ptr<sf::Texture> getTexture(const std::string& path);
+
+    // Drop the assets that aren't used outside of the cache anymore
+    void releaseUnused();
+
+    // Get the memory of the loaded textures in bytes. Font atlases grow with the rendered glyphs and aren't included
+    [[nodiscard]] size_t getMemoryUsage() const;
+
+private:
+    // Loaded assets by file path
+    std::unordered_map<std::string, std::shared_ptr<sf::Font>> fonts_;
+    std::unordered_map<std::string, std::shared_ptr<sf::Texture>> textures_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_ASSETCACHE_H
@@ -0,0 +1,116 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Container.h"
+#include "Plot.h"
+
+// Rows of the benchmark tree and elements per row. Together with the root and the rows, the tree has 100,001 nodes
+static constexpr size_t rowCount = 1000;
+static constexpr size_t elementsPerRow = 99;
+
+// Samples appended to the plot in total, per append call and per frame, i.e., between two layout updates
+static constexpr size_t plotSampleCount = 20000000;
+static constexpr size_t plotAppendCount = 1000;
+static constexpr size_t plotSamplesPerFrame = 100000;
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Build a root with a vertical list of rows, each a horizontal list of containers, as a large screen would
+ * - The root is sized before anything is added, so that every insertion updates the layout unless a batch is open
+ * - Computing the render information of the whole tree afterward is timed separately
+ */
+// ___________________________________________________________________________
+static void benchmarkTreeBuild(bool useBatch) {
+    sf::Clock clock;
+
+    Container root("Root", sf::Vector2f(1, 1));
+    root.setParentSize(sf::Vector2f(1920, 1080));
+    root.setLayoutOrientation(LayoutOrientation::Vertical);
+    root.reserve(rowCount);
+
+    if (useBatch) {
+        root.beginBatch();
+    }
+    for (size_t row = 0; row < rowCount; row++) {
+        auto rowContainer = std::make_unique<Container>("Row" + std::to_string(row),
+                                                        sf::Vector2f(1, 1.f / rowCount));
+        rowContainer->setLayoutOrientation(LayoutOrientation::Horizontal);
+        rowContainer->reserve(elementsPerRow);
+        for (size_t element = 0; element < elementsPerRow; element++) {
+            rowContainer->addContainer(std::make_unique<Container>("Element" + std::to_string(element),
+                                                                   sf::Vector2f(1.f / elementsPerRow, 1)));
+        }
+        root.addContainer(std::move(rowContainer));
+    }
+    if (useBatch) {
+        root.commitBatch();
+    }
+    sf::Time buildTime = clock.restart();
+
+    root.updateLayout();
+    sf::Time layoutTime = clock.restart();
+
+    std::cout << "Tree of " << 1 + rowCount * (1 + elementsPerRow) << " nodes " << (useBatch ? "with" : "without")
+              << " batch: build " << buildTime.asMilliseconds() << " ms, layout " << layoutTime.asMilliseconds()
+              << " ms" << std::endl;
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Stream a sine wave with one sample per microsecond into a plot showing the last second, as a sensor would
+ * - Append the samples in blocks and update the render information once per frame worth of samples, so that the
+ * columns and line strips are rebuilt as often as they would be when drawing
+ */
+// ___________________________________________________________________________
+static void benchmarkPlot(Decimation decimation) {
+    Plot plot("Plot", sf::Vector2f(1, 1), 1);
+    plot.setParentSize(sf::Vector2f(1920, 400));
+    size_t series = plot.addSeries(sf::Color::Green, decimation, 1 << 20);
+
+    std::vector<double> times(plotAppendCount);
+    std::vector<float> values(plotAppendCount);
+    sf::Clock clock;
+    sf::Time appendTime;
+    sf::Time updateTime;
+
+    for (size_t sample = 0; sample < plotSampleCount; sample += plotAppendCount) {
+        for (size_t index = 0; index < plotAppendCount; index++) {
+            times[index] = static_cast<double>(sample + index) * 1e-6;
+            values[index] = std::sin(static_cast<float>(times[index]) * 50);
+        }
+
+        clock.restart();
+        plot.append(series, times.data(), values.data(), plotAppendCount);
+        appendTime += clock.restart();
+
+        if ((sample + plotAppendCount) % plotSamplesPerFrame == 0) {
+            plot.updateRenderInformation();
+            updateTime += clock.restart();
+        }
+    }
+
+    double samplesPerSecond = static_cast<double>(plotSampleCount) / (appendTime + updateTime).asSeconds();
+    std::cout << "Plot with " << (decimation == Decimation::MinMax ? "min-max" : "largest triangle")
+              << " decimation: " << plotSampleCount << " samples, append " << appendTime.asMilliseconds()
+              << " ms, update " << updateTime.asMilliseconds() << " ms, " << samplesPerSecond / 1e6
+              << " million samples per second, " << plot.getVertexCount(series) << " vertices" << std::endl;
+}
+
+int main() {
+    benchmarkTreeBuild(false);
+    benchmarkTreeBuild(true);
+
+    benchmarkPlot(Decimation::MinMax);
+    benchmarkPlot(Decimation::LargestTriangle);
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "Binding.h"
+
+#include <algorithm>
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Swap the pending observables out first, so that bindings writing to other observables add them to the next
+ * change set instead of invalidating the iteration
+ * - Each observable compares its final value with the applied one and only calls its bindings if they differ
+ */
+// ___________________________________________________________________________
+void ChangeSet::apply() {
+    std::vector<ObservableBase*> observables;
+    observables.swap(pendingObservables_);
+
+    for (auto* observable: observables) {
+        observable->isPending_ = false;
+        if (observable->applyPending(statistics_.bindingCalls)) {
+            statistics_.appliedChanges++;
+        }
+    }
+
+    // Keep the capacity for the next frame
+    if (pendingObservables_.empty()) {
+        observables.clear();
+        pendingObservables_.swap(observables);
+    }
+}
+
+// ___________________________________________________________________________
+bool ChangeSet::isEmpty() const {
+    return pendingObservables_.empty();
+}
+
+// ___________________________________________________________________________
+const ChangeSetStatistics &ChangeSet::getStatistics() const {
+    return statistics_;
+}
+
+// ___________________________________________________________________________
+void ChangeSet::resetStatistics() {
+    statistics_ = ChangeSetStatistics();
+}
+
+// ___________________________________________________________________________
+void ChangeSet::add(ObservableBase *observable) {
+    pendingObservables_.push_back(observable);
+}
+
+// ___________________________________________________________________________
+void ChangeSet::remove(ObservableBase *observable) {
+    pendingObservables_.erase(std::remove(pendingObservables_.begin(), pendingObservables_.end(), observable),
+                              pendingObservables_.end());
+}
+
+// ___________________________________________________________________________
+ObservableBase::ObservableBase(ChangeSet &changeSet) : changeSet_(changeSet) {}
+
+// ___________________________________________________________________________
+ObservableBase::~ObservableBase() {
+    // The change set mustn't apply a destroyed observable
+    if (isPending_) {
+        changeSet_.remove(this);
+    }
+}
+
+// ___________________________________________________________________________
+void ObservableBase::markPending() {
+    if (not isPending_) {
+        isPending_ = true;
+        changeSet_.add(this);
+    }
+}
+
+// ___________________________________________________________________________
+void ObservableBase::countWrite() {
+    changeSet_.statistics_.writes++;
+}
@@ -0,0 +1,193 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_BINDING_H
+#define SWIFTIFYSFML_V0_1_BINDING_H
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include "Container.h"
+#include "UIComponent.h"
+
+/*
+ * ChangeSetStatistics struct. Counters of a change set. Writes are all values set on observables, applied changes
+ * are the values that actually differed from the displayed ones, and binding calls are the resulting UI updates.
+ */
+struct ChangeSetStatistics {
+    size_t writes = 0;
+    size_t appliedChanges = 0;
+    size_t bindingCalls = 0;
+};
+
+// Forward declaration of the observable base class
+class ObservableBase;
+
+/*
+ * ChangeSet class. Collects the observables changed during a frame and applies them at once before the layout is
+ * computed. An observable written several times per frame is applied once, and only if its final value differs from
+ * the applied one. Bindings may write to other observables, which are applied with the next change set, but mustn't
+ * destroy observables.
+ */
+class ChangeSet {
+public:
+    // Constructor and destructor
+    ChangeSet() = default;
+    ~ChangeSet() = default;
+
+    // Apply all collected changes to their bindings and clear the change set
+    void apply();
+
+    // Returns true if no change is waiting to be applied
+    [[nodiscard]] bool isEmpty() const;
+
+    // Get and reset the counters
+    [[nodiscard]] const ChangeSetStatistics& getStatistics() const;
+    void resetStatistics();
+
+private:
+    // Observables add and remove themselves when they get pending changes or are destroyed
+    friend class ObservableBase;
+    void add(ObservableBase* observable);
+    void remove(ObservableBase* observable);
+
+    // Observables with pending changes, in the order of their first write
+    std::vector<ObservableBase*> pendingObservables_;
+
+    // Counters
+    ChangeSetStatistics statistics_;
+};
+
+/*
+ * ObservableBase class. Type-independent part of an observable, used by the change set.
+ */
+class ObservableBase {
+public:
+    // Delete copy and move operations. The change set refers to observables by address
+    ObservableBase(const ObservableBase&) = delete;
+    ObservableBase& operator=(const ObservableBase&) = delete;
+
+protected:
+    // Constructor and destructor. The destructor removes pending changes from the change set
+    explicit ObservableBase(ChangeSet& changeSet);
+    virtual ~ObservableBase();
+
+    // Add the observable to the change set, if it isn't part of it yet
+    void markPending();
+
+    // Count a write in the change set's statistics
+    void countWrite();
+
+    // Apply the pending value if it differs from the applied one. Returns true if it did and adds the number of
+    // binding calls
+    virtual bool applyPending(size_t& bindingCalls) = 0;
+
+private:
+    friend class ChangeSet;
+
+    ChangeSet& changeSet_;
+    bool isPending_ = false;
+};
+
+/*
+ * Observable class. Model property that UI elements can bind to. Setting a value doesn't touch the UI. The value is
+ * applied to the bindings when the change set is applied, which the application does once per frame after the events
+ * have been dispatched. Writes of the latest value are dropped right away, and values written back to the applied one
+ * are dropped when the change set is applied.
+ *
+ * T has to be copyable and comparable with ==.
+ */
+template<typename T>
+class Observable : public ObservableBase {
+public:
+    // Constructor and destructor
+    Observable(ChangeSet& changeSet, T value) : ObservableBase(changeSet), value_(value),
+                                                pendingValue_(std::move(value)) {}
+    ~Observable() override = default;
+
+    // Set a new value. It's applied with the next change set
+    void set(T value) {
+        countWrite();
+
+        // Writes of the latest value don't change anything. Values written back to the applied one are dropped when
+        // the change set is applied
+        if (value == pendingValue_) {
+            return;
+        }
+        pendingValue_ = std::move(value);
+        markPending();
+    }
+
+    // Get the value that has been applied to the bindings, and the latest value including pending writes
+    [[nodiscard]] const T& get() const {
+        return value_;
+    }
+    [[nodiscard]] const T& getPending() const {
+        return pendingValue_;
+    }
+
+    // Call the function with every applied change. It's called with the current value right away
+    void bind(std::function<void(const T&)> binding) {
+        binding(value_);
+        bindings_.push_back([binding = std::move(binding)](const T& value) {
+            binding(value);
+            return true;
+        });
+    }
+
+    // Bind a property of a container or UI component. The binding is dropped once the element doesn't exist anymore
+    void bind(ContainerHandle container, std::function<void(Container&, const T&)> binding) {
+        bindElement<Container>(container, std::move(binding));
+    }
+    void bind(UIComponentHandle component, std::function<void(UIComponent&, const T&)> binding) {
+        bindElement<UIComponent>(component, std::move(binding));
+    }
+
+protected:
+    // Compare the pending with the applied value and call the bindings only if they differ
+    bool applyPending(size_t& bindingCalls) override {
+        if (pendingValue_ == value_) {
+            return false;
+        }
+        value_ = pendingValue_;
+
+        // Call the bindings and drop the ones whose element has been destroyed
+        for (size_t index = 0; index < bindings_.size();) {
+            if (bindings_[index](value_)) {
+                bindingCalls++;
+                index++;
+            } else {
+                bindings_[index] = std::move(bindings_.back());
+                bindings_.pop_back();
+            }
+        }
+        return true;
+    }
+
+private:
+    // Wrap a binding to an element, so that it resolves the handle first. Returns false once the element is gone
+    template<typename Element>
+    void bindElement(Handle<Element> element, std::function<void(Element&, const T&)> binding) {
+        if (Element* resolvedElement = Element::resolve(element)) {
+            binding(*resolvedElement, value_);
+        }
+        bindings_.push_back([element, binding = std::move(binding)](const T& value) {
+            Element* resolvedElement = Element::resolve(element);
+            if (!resolvedElement) {
+                return false;
+            }
+            binding(*resolvedElement, value);
+            return true;
+        });
+    }
+
+    // Applied value and the latest written value
+    T value_;
+    T pendingValue_;
+
+    // Bindings returning false if they are outdated
+    std::vector<std::function<bool(const T&)>> bindings_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_BINDING_H
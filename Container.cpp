@@ -28,9 +28,21 @@
 
 
 #include "Container.h"
+#include "ShapeGeometry.h"
+#include "FocusManager.h"
 
 #include <utility>
 #include <iostream>
+#include <numeric>
+#include <cmath>
+
+// Default memory limit for all cached layers: 64 MiB
+size_t Container::layerMemoryUsage_ = 0;
+size_t Container::layerMemoryLimit_ = 64 * 1024 * 1024;
+BatchStatistics Container::batchStatistics_;
+
+// Batches that are rebuilt after fewer draws than this are considered dynamic and use a streaming buffer
+static constexpr size_t staticBatchMinDraws = 4;
 
 // ___________________________________________________________________________
 Container::Container(std::string name, sf::Vector2f sizeProportions)
@@ -40,14 +52,46 @@ Container::Container(std::string name, sf::Vector2f sizeProportions)
     layoutOrientation_ = LayoutOrientation::None;
     alignment_ = Alignment::Center;
     needRenderUpdate_ = true;
+    needGridUpdate_ = true;
     isVisible_ = true;
 
     // Should this be true or false? And should this be renamed to isDisabled?
     isEnabled_ = true;
+
+    // Register the container to get a stable handle
+    handle_ = getRegistry().insert(this);
+}
+
+// ___________________________________________________________________________
+Container::~Container() {
+    // Notify running animations that the container doesn't exist anymore
+    if (animationState_) {
+        animationState_->isAttached = false;
+    }
+
+    // Return the layer's memory to the layer memory limit
+    releaseLayer();
+
+    // Invalidate all handles to this container
+    getRegistry().erase(handle_);
+}
+
+// ___________________________________________________________________________
+Container *Container::resolve(ContainerHandle handle) {
+    return getRegistry().resolve(handle);
 }
 
+// ___________________________________________________________________________
+SlotMap<Container> &Container::getRegistry() {
+    // Constructed on first use, so it exists before any container
+    static SlotMap<Container> registry;
+    return registry;
+}
+
+// ___________________________________________________________________________
 Container::Container(Container&& other) noexcept : needRenderUpdate_(other.needRenderUpdate_),
                                                    name_(std::move(other.name_)),
+                                                   handle_(other.handle_),
                                                    parentSize_(other.parentSize_),
                                                    sizeProportions_(other.sizeProportions_),
                                                    paddingProportions_(other.paddingProportions_),
@@ -56,18 +100,53 @@ Container::Container(Container&& other) noexcept : needRenderUpdate_(other.needR
                                                    size_(other.size_),
                                                    padding_(other.padding_),
                                                    spacing_(other.spacing_),
+                                                   expressions_(std::move(other.expressions_)),
+                                                   expressionInputMask_(other.expressionInputMask_),
+                                                   hasSiblingExpressions_(other.hasSiblingExpressions_),
                                                    layoutOrientation_(other.layoutOrientation_),
                                                    alignment_(other.alignment_),
                                                    elements_(std::move(other.elements_)),
-                                                   callback_(std::move(other.callback_)),
+                                                   grid_(std::move(other.grid_)),
+                                                   needGridUpdate_(other.needGridUpdate_),
+                                                   callbacks_(std::move(other.callbacks_)),
+                                                   callbackMask_(other.callbackMask_),
+                                                   subtreeCallbackMask_(other.subtreeCallbackMask_),
                                                    isEnabled_(other.isEnabled_),
                                                    isVisible_(other.isVisible_),
-                                                   backgroundShape_(std::move(other.backgroundShape_)) {}
+                                                   backgroundShape_(std::move(other.backgroundShape_)),
+                                                   decoration_(std::move(other.decoration_)),
+                                                   style_(std::move(other.style_)),
+                                                   styleOverrides_(std::move(other.styleOverrides_)),
+                                                   animationState_(std::move(other.animationState_)),
+                                                   cacheAsLayer_(other.cacheAsLayer_),
+                                                   layer_(std::move(other.layer_)),
+                                                   batch_(std::move(other.batch_)) {
+    // Let the handle, the animations and nested elements refer to the new address
+    getRegistry().update(handle_, this);
+    other.handle_ = ContainerHandle();
+    if (animationState_) {
+        animationState_->owner = this;
+    }
+    for (auto& element: elements_) {
+        std::visit([this](auto& el) { el->setParent(this); }, element);
+    }
+}
 
 Container& Container::operator=(Container&& other) noexcept {
     if (this != &other) {
         needRenderUpdate_ = other.needRenderUpdate_;
         name_ = std::move(other.name_);
+
+        // Stop using the own style. The other style's registration moves along with the handle
+        if (style_) {
+            style_->removeUser(handle_);
+        }
+
+        // Take over the other handle. Handles to this container become invalid
+        getRegistry().erase(handle_);
+        handle_ = other.handle_;
+        other.handle_ = ContainerHandle();
+        getRegistry().update(handle_, this);
         parentSize_ = other.parentSize_;
         sizeProportions_ = other.sizeProportions_;
         paddingProportions_ = other.paddingProportions_;
@@ -76,52 +155,179 @@ Container& Container::operator=(Container&& other) noexcept {
         size_ = other.size_;
         padding_ = other.padding_;
         spacing_ = other.spacing_;
+        expressions_ = std::move(other.expressions_);
+        expressionInputMask_ = other.expressionInputMask_;
+        hasSiblingExpressions_ = other.hasSiblingExpressions_;
         layoutOrientation_ = other.layoutOrientation_;
         alignment_ = other.alignment_;
         elements_ = std::move(other.elements_);
-        callback_ = std::move(other.callback_);
+        grid_ = std::move(other.grid_);
+        needGridUpdate_ = other.needGridUpdate_;
+        callbacks_ = std::move(other.callbacks_);
+        callbackMask_ = other.callbackMask_;
+        subtreeCallbackMask_ = other.subtreeCallbackMask_;
         isEnabled_ = other.isEnabled_;
         isVisible_ = other.isVisible_;
         backgroundShape_ = std::move(other.backgroundShape_);
+        decoration_ = std::move(other.decoration_);
+
+        style_ = std::move(other.style_);
+        styleOverrides_ = std::move(other.styleOverrides_);
+
+        // Detach the animations of the replaced state before taking over the other one
+        if (animationState_) {
+            animationState_->isAttached = false;
+        }
+        animationState_ = std::move(other.animationState_);
+
+        // Release the own layer before taking over the other one
+        releaseLayer();
+        cacheAsLayer_ = other.cacheAsLayer_;
+        layer_ = std::move(other.layer_);
+        batch_ = std::move(other.batch_);
+
+        // Let the animations and nested elements refer to the new address
+        if (animationState_) {
+            animationState_->owner = this;
+        }
+        for (auto& element: elements_) {
+            std::visit([this](auto& el) { el->setParent(this); }, element);
+        }
     }
     return *this;
 }
 
 // ___________________________________________________________________________
 void Container::setParentSize(sf::Vector2f parentSize) {
+    // Only recompute the subtree if the size actually changed, e.g., when an element is moved between containers
+    if (parentSize_ == parentSize) {
+        return;
+    }
+
+    // Only the expressions depending on the changed axes are re-evaluated
+    unsigned changedInputs = 0;
+    if (parentSize_.x != parentSize.x) {
+        changedInputs |= toInputMask(ExpressionInput::ParentWidth);
+    }
+    if (parentSize_.y != parentSize.y) {
+        changedInputs |= toInputMask(ExpressionInput::ParentHeight);
+    }
+
     parentSize_ = parentSize;
-    computeSize();
+    computeSize(changedInputs);
 
     // Update render update flag
-    needRenderUpdate_ = true;
+    requestRenderUpdate();
 }
 
 // ___________________________________________________________________________
 void Container::setSizeProportions(sf::Vector2f sizeProportions) {
-    // Update containers size and size proportions
+    // Update containers size and size proportions. The proportions replace the size expressions
     sizeProportions_ = sizeProportions;
+    setExpressions(sizeDimension, std::nullopt, std::nullopt);
     computeSize();
 
-    // Update render update flag
-    needRenderUpdate_ = true;
+    // Update render update flag and the siblings depending on the size
+    requestRenderUpdate();
+    if (parent_) {
+        parent_->updateSiblingExpressions();
+    }
 }
 
 // ___________________________________________________________________________
 void Container::setPaddingProportions(sf::Vector2f paddingProportions) {
+    // Override the value of the style for this container only
+    if (style_) {
+        getStyleOverrides().setPaddingProportions(paddingProportions);
+        applyStyle(true);
+        return;
+    }
+
     paddingProportions_ = paddingProportions;
+    setExpressions(paddingDimension, std::nullopt, std::nullopt);
     computePadding();
 
     // Update render update flag
-    needRenderUpdate_ = true;
+    requestRenderUpdate();
 }
 
 // ___________________________________________________________________________
 void Container::setSpacingProportions(sf::Vector2f spacingProportions) {
+    // Override the value of the style for this container only
+    if (style_) {
+        getStyleOverrides().setSpacingProportions(spacingProportions);
+        applyStyle(true);
+        return;
+    }
+
     spacingProportions_ = spacingProportions;
+    setExpressions(spacingDimension, std::nullopt, std::nullopt);
     computeSpacing();
 
     // Update render update flag
-    needRenderUpdate_ = true;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void Container::setSizeExpressions(Expression width, Expression height) {
+    // The size is an input of the padding and spacing, so it can't depend on itself
+    unsigned ownSizeMask = toInputMask(ExpressionInput::Width) | toInputMask(ExpressionInput::Height);
+    if ((width.getInputMask() | height.getInputMask()) & ownSizeMask) {
+        throw std::runtime_error("Size expressions can't depend on the container's own size.");
+    }
+    if (isSiblingCycle(width, height)) {
+        throw std::runtime_error("Size expressions of container '" + name_ + "' form a cycle through its siblings.");
+    }
+
+    setExpressions(sizeDimension, std::move(width), std::move(height));
+    computeSize();
+
+    // Update render update flag and the siblings depending on the size
+    requestRenderUpdate();
+    if (parent_) {
+        parent_->updateSiblingExpressions();
+    }
+}
+
+// ___________________________________________________________________________
+void Container::setPaddingExpressions(Expression x, Expression y) {
+    setExpressions(paddingDimension, std::move(x), std::move(y));
+    computePadding();
+
+    // Update render update flag
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void Container::setSpacingExpressions(Expression x, Expression y) {
+    setExpressions(spacingDimension, std::move(x), std::move(y));
+    computeSpacing();
+
+    // Update render update flag
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void Container::setExpressions(size_t dimension, std::optional<Expression> x, std::optional<Expression> y) {
+    if (!expressions_) {
+        if (!x and !y) {
+            return;
+        }
+        expressions_ = std::make_unique<std::array<std::optional<Expression>, 6>>();
+    }
+    (*expressions_)[dimension] = std::move(x);
+    (*expressions_)[dimension + 1] = std::move(y);
+
+    // Collect the inputs of all expressions, used to find the containers depending on their siblings
+    expressionInputMask_ = 0;
+    for (auto& expression: *expressions_) {
+        if (expression) {
+            expressionInputMask_ |= expression->getInputMask();
+        }
+    }
+    if (parent_ and (expressionInputMask_ & toInputMask(ExpressionInput::Sibling))) {
+        parent_->hasSiblingExpressions_ = true;
+    }
 }
 
 // ___________________________________________________________________________
@@ -129,22 +335,33 @@ void Container::setPosition(sf::Vector2f position) {
     position_ = position;
 
     // Update render update flag
-    needRenderUpdate_ = true;
+    requestRenderUpdate();
 }
 
 void Container::updatePosition(sf::Vector2f offset) {
     position_ += offset;
 
     // Update render update flag
-    needRenderUpdate_ = true;
+    requestRenderUpdate();
 }
 
 // ___________________________________________________________________________
 void Container::setLayoutOrientation(LayoutOrientation layoutOrientation) {
+    // Switching from or to a grid layout changes the parent size of the nested elements
+    bool gridChanged = (layoutOrientation_ == LayoutOrientation::Grid) != (layoutOrientation == LayoutOrientation::Grid);
     layoutOrientation_ = layoutOrientation;
 
+    if (gridChanged) {
+        // Forget the cached cell sizes, so that the grid pass assigns them again, and propagate the new parent size
+        GridState& grid = getGridState();
+        for (auto& placement: grid.placements) {
+            placement.cellSize = sf::Vector2f(-1, -1);
+        }
+        computeSize();
+    }
+
     // Update render update flag
-    needRenderUpdate_ = true;
+    requestRenderUpdate();
 }
 
 // ___________________________________________________________________________
@@ -152,14 +369,102 @@ void Container::setAlignment(Alignment alignment) {
     alignment_ = alignment;
 
     // Update render update flag
-    needRenderUpdate_ = true;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void Container::setGridTracks(std::vector<float> columnProportions, std::vector<float> rowProportions) {
+    GridState& grid = getGridState();
+    grid.columnProportions = std::move(columnProportions);
+    grid.rowProportions = std::move(rowProportions);
+
+    // Update grid and render update flags
+    needGridUpdate_ = true;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void Container::setGridCell(const std::string &name, GridCell cell) {
+    for (size_t index = 0; index < elements_.size(); index++) {
+        // Use std::visit to get the name of the element
+        auto& elementName = std::visit([](auto& el) -> const std::string& { return el->getName(); }, elements_[index]);
+
+        if (elementName == name) {
+            getGridState().placements[index].cell = cell;
+
+            // Update grid and render update flags
+            needGridUpdate_ = true;
+            requestRenderUpdate();
+            return;
+        }
+    }
+    // If no matching name is found
+    throw std::runtime_error("No matching name found.");
 }
 
 // ___________________________________________________________________________
 // Can it cause problems when the function is being moved here?
 // ___________________________________________________________________________
 void Container::setCallback(std::function<void()> callback) {
-    callback_ = std::move(callback);
+    if (callback) {
+        setCallback(CallbackType::Click, [callback = std::move(callback)](const sf::Event&) { callback(); });
+    } else {
+        setCallback(CallbackType::Click, nullptr);
+    }
+}
+
+// ___________________________________________________________________________
+void Container::setCallback(CallbackType type, std::function<void(const sf::Event &)> callback) {
+    // Allocate the callback table with the first callback
+    if (callback and !callbacks_) {
+        callbacks_ = std::make_unique<CallbackTable>();
+    }
+    if (callbacks_) {
+        (*callbacks_)[static_cast<size_t>(type)] = std::move(callback);
+    }
+
+    // Update the own mask and the subtree masks up the parent chain
+    if (callbacks_ and (*callbacks_)[static_cast<size_t>(type)]) {
+        callbackMask_ |= toCallbackMask(type);
+    } else {
+        callbackMask_ &= ~toCallbackMask(type);
+    }
+    updateCallbackMask();
+}
+
+// ___________________________________________________________________________
+void Container::updateCallbackMask() {
+    unsigned subtreeCallbackMask = callbackMask_;
+    for (auto& element: elements_) {
+        subtreeCallbackMask |= std::visit([](auto& el) -> unsigned { return el->getCallbackMask(); }, element);
+    }
+
+    // Only walk further up if something changed
+    if (subtreeCallbackMask != subtreeCallbackMask_) {
+        subtreeCallbackMask_ = subtreeCallbackMask;
+        if (parent_) {
+            parent_->updateCallbackMask();
+        }
+    }
+}
+
+// ___________________________________________________________________________
+unsigned Container::getCallbackMask() const {
+    return subtreeCallbackMask_;
+}
+
+// ___________________________________________________________________________
+FocusManager *Container::getFocusManager() const {
+    const Container* root = this;
+    while (root->parent_) {
+        root = root->parent_;
+    }
+    return root->focusManager_;
+}
+
+// ___________________________________________________________________________
+void Container::setParent(Container *parent) {
+    parent_ = parent;
 }
 
 // ___________________________________________________________________________
@@ -167,7 +472,7 @@ void Container::setVisible(bool visible) {
     // Only update visibility and render update flag if needed
     if (isVisible_ != visible) {
         isVisible_ = visible;
-        needRenderUpdate_ = true;
+        requestRenderUpdate();
     }
 }
 
@@ -181,27 +486,162 @@ void Container::setEnabled(bool enabled) {
 
 // ___________________________________________________________________________
 void Container::setOutline(sf::Color color, float thickness) {
-    // Create a background shape instance if it doesn't exist yet
-    if (!backgroundShape_) {
-        backgroundShape_ = std::make_unique<sf::RectangleShape>();
+    // Override the value of the style for this container only
+    if (style_) {
+        getStyleOverrides().setOutline(color, thickness);
+        applyStyle(false);
+        return;
     }
 
     // Set the outline attributes
-    backgroundShape_->setOutlineColor(color);
+    getBackgroundShape().setOutlineColor(color);
     backgroundShape_->setOutlineThickness(thickness);
+    invalidateLayers();
 }
 
 // ___________________________________________________________________________
 void Container::setBackground(sf::Color color) {
-    // Create a background shape instance if it doesn't exist yet
-    if (!backgroundShape_) {
-        backgroundShape_ = std::make_unique<sf::RectangleShape>();
+    // Override the value of the style for this container only
+    if (style_) {
+        getStyleOverrides().setBackground(color);
+        applyStyle(false);
+        return;
+    }
+
+    // Set the background color. It replaces an animated color until the next step of a running color tween
+    getBackgroundShape().setFillColor(color);
+    if (animationState_) {
+        animationState_->hasBackgroundColor = false;
+    }
+    invalidateLayers();
+}
+
+// ___________________________________________________________________________
+void Container::setCornerRadius(float cornerRadius) {
+    // Override the value of the style for this container only
+    if (style_) {
+        getStyleOverrides().setCornerRadius(cornerRadius);
+        applyStyle(false);
+        return;
+    }
+
+    getDecoration().cornerRadius = cornerRadius;
+    invalidateLayers();
+}
+
+// ___________________________________________________________________________
+void Container::setShadow(Shadow shadow) {
+    // Override the value of the style for this container only
+    if (style_) {
+        getStyleOverrides().setShadow(shadow);
+        applyStyle(false);
+        return;
+    }
+
+    getDecoration().shadow = shadow;
+    invalidateLayers();
+}
+
+// ___________________________________________________________________________
+// Get a style value from the overrides of a container if it is set there, else from its shared style
+// ___________________________________________________________________________
+template<typename T>
+static const std::optional<T>& resolveStyleValue(const Style* overrides, const Style& style,
+                                                 const std::optional<T>& (Style::*getter)() const) {
+    if (overrides and (overrides->*getter)()) {
+        return (overrides->*getter)();
+    }
+    return (style.*getter)();
+}
+
+// ___________________________________________________________________________
+void Container::setStyle(std::shared_ptr<Style> style) {
+    if (style_ == style) {
+        return;
+    }
+
+    // Move the registration from the old to the new style
+    if (style_) {
+        style_->removeUser(handle_);
+    }
+    style_ = std::move(style);
+
+    if (style_) {
+        style_->addUser(handle_);
+
+        // Only a different padding or spacing requires a layout update
+        const auto& padding = resolveStyleValue(styleOverrides_.get(), *style_, &Style::getPaddingProportions);
+        const auto& spacing = resolveStyleValue(styleOverrides_.get(), *style_, &Style::getSpacingProportions);
+        bool affectsGeometry = (padding and *padding != paddingProportions_) or
+                               (spacing and *spacing != spacingProportions_);
+        applyStyle(affectsGeometry);
+    } else {
+        // Without a style, the setters change the values directly again
+        styleOverrides_ = nullptr;
+    }
+}
+
+// ___________________________________________________________________________
+const std::shared_ptr<Style> &Container::getStyle() const {
+    return style_;
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Each value is taken from the container's overrides if it is set there, else from the shared style. Only the values
+ * set in either of them are applied
+ * - Colors and the outline are drawn from the background shape, corners and shadow from the decoration. Changing
+ * them never affects the layout, so only the cached layers are invalidated
+ * - Padding and spacing are recomputed and trigger a layout update if they might have changed
+ */
+// ___________________________________________________________________________
+void Container::applyStyle(bool affectsGeometry) {
+    if (!style_) {
+        return;
+    }
+    const Style* overrides = styleOverrides_.get();
+
+    if (const auto& background = resolveStyleValue(overrides, *style_, &Style::getBackground)) {
+        getBackgroundShape().setFillColor(*background);
+        if (animationState_) {
+            animationState_->hasBackgroundColor = false;
+        }
     }
 
-    // Set the background color
-    backgroundShape_->setFillColor(color);
+    // The outline thickness belongs to the outline color it has been set with
+    const Style& outlineStyle = overrides and overrides->getOutlineColor() ? *overrides : *style_;
+    if (outlineStyle.getOutlineColor()) {
+        getBackgroundShape().setOutlineColor(*outlineStyle.getOutlineColor());
+        backgroundShape_->setOutlineThickness(outlineStyle.getOutlineThickness());
+    }
+    if (const auto& cornerRadius = resolveStyleValue(overrides, *style_, &Style::getCornerRadius)) {
+        getDecoration().cornerRadius = *cornerRadius;
+    }
+    if (const auto& shadow = resolveStyleValue(overrides, *style_, &Style::getShadow)) {
+        getDecoration().shadow = *shadow;
+    }
+
+    if (not affectsGeometry) {
+        invalidateLayers();
+        return;
+    }
+
+    if (const auto& padding = resolveStyleValue(overrides, *style_, &Style::getPaddingProportions)) {
+        paddingProportions_ = *padding;
+        computePadding();
+    }
+    if (const auto& spacing = resolveStyleValue(overrides, *style_, &Style::getSpacingProportions)) {
+        spacingProportions_ = *spacing;
+        computeSpacing();
+    }
+    requestRenderUpdate();
 }
 
+// ___________________________________________________________________________
+ContainerHandle Container::getHandle() const {
+    return handle_;
+}
 
 // ___________________________________________________________________________
 const std::string &Container::getName() const {
@@ -228,194 +668,1197 @@ const sf::Vector2f &Container::getSpacing() const {
     return spacing_;
 }
 
-// ___________________________________________________________________________
-const bool &Container::isVisible() const {
-    return isVisible_;
+// ___________________________________________________________________________
+const bool &Container::isVisible() const {
+    return isVisible_;
+}
+
+// ___________________________________________________________________________
+const bool &Container::isEnabled() const {
+    return isEnabled_;
+}
+
+// ___________________________________________________________________________
+bool Container::isHovered() const {
+    return isHovered_;
+}
+
+// ___________________________________________________________________________
+bool Container::isPressed() const {
+    return isPressed_;
+}
+
+// ___________________________________________________________________________
+void Container::setCacheAsLayer(bool cacheAsLayer) {
+    cacheAsLayer_ = cacheAsLayer;
+    failedLayerSize_.reset();
+
+    // Free the texture memory right away if the layer isn't needed anymore
+    if (!cacheAsLayer_) {
+        releaseLayer();
+    }
+
+    // The parent layers have to be redrawn either way
+    invalidateLayers();
+}
+
+// ___________________________________________________________________________
+void Container::setStaticBatch(bool staticBatch) {
+    if (staticBatch and !batch_) {
+        batch_ = std::make_unique<Batch>();
+    } else if (not staticBatch) {
+        batch_ = nullptr;
+    }
+
+    // The parent layers and batches have to be redrawn either way
+    invalidateLayers();
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Walk up the parent chain to the root and mark every cached layer and batch as outdated
+ * - Layers and batches that are already outdated don't end the walk, since their ancestors might have been rebuilt
+ * without them in the meantime
+ */
+// ___________________________________________________________________________
+void Container::invalidateLayers(bool includeSelf) {
+    // Walk up to the root even past outdated layers. An outdated layer doesn't imply outdated ancestors, e.g., an
+    // invisible layer stays outdated while its parent is rendered again without it
+    for (Container* container = includeSelf ? this : parent_; container; container = container->parent_) {
+        if (container->layer_) {
+            container->layer_->isValid = false;
+        }
+        if (container->batch_) {
+            container->batch_->isValid = false;
+        }
+    }
+}
+
+// ___________________________________________________________________________
+void Container::setLayerMemoryLimit(size_t bytes) {
+    layerMemoryLimit_ = bytes;
+}
+
+// ___________________________________________________________________________
+size_t Container::getLayerMemoryLimit() {
+    return layerMemoryLimit_;
+}
+
+// ___________________________________________________________________________
+size_t Container::getLayerMemoryUsage() {
+    return layerMemoryUsage_;
+}
+
+// ___________________________________________________________________________
+const BatchStatistics &Container::getBatchStatistics() {
+    return batchStatistics_;
+}
+
+// ___________________________________________________________________________
+void Container::resetBatchStatistics() {
+    batchStatistics_ = BatchStatistics();
+}
+
+// ___________________________________________________________________________
+std::shared_ptr<AnimationState> Container::getAnimationState() {
+    if (!animationState_) {
+        animationState_ = std::make_shared<AnimationState>();
+        animationState_->owner = this;
+    }
+
+    return animationState_;
+}
+
+// ___________________________________________________________________________
+void Container::releaseAnimationState() {
+    // Keep the state while running tweens or other owners share it, or while it still changes the container
+    if (!animationState_ or animationState_.use_count() > 1) {
+        return;
+    }
+    const AnimationState& state = *animationState_;
+    if (state.offset != sf::Vector2f(0, 0) or state.scale != sf::Vector2f(1, 1) or state.opacity != 1
+        or state.hasBackgroundColor) {
+        return;
+    }
+
+    // Batches containing this container collect its background again
+    animationState_.reset();
+    invalidateLayers();
+}
+
+// ___________________________________________________________________________
+void Container::takeAnimatedBackground() {
+    if (!animationState_ or !animationState_->hasBackgroundColor) {
+        return;
+    }
+
+    getBackgroundShape().setFillColor(animationState_->backgroundColor);
+    animationState_->hasBackgroundColor = false;
+    invalidateLayers();
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Count the container object with its name and callback table as node memory
+ * - Count the element vector, the grid state and the expressions as layout memory
+ * - Count the background shape, the style and the animation state as render memory. A shared style is split evenly
+ * between its owners, so that it's counted once in total
+ * - Count the cached layer including its texture memory and the batch including its vertex buffer as cache memory,
+ * and recurse into the nested elements
+ */
+// ___________________________________________________________________________
+void Container::collectMemoryUsage(MemoryReport &report) const {
+    report.containerCount++;
+    report.containerBytes += sizeof(Container) + getHeapBytes(name_);
+    if (callbacks_) {
+        report.containerBytes += sizeof(CallbackTable);
+    }
+
+    report.layoutBytes += elements_.capacity() * sizeof(ElementType);
+    if (grid_) {
+        report.layoutBytes += sizeof(GridState) + grid_->placements.capacity() * sizeof(GridPlacement) +
+                              (grid_->columnProportions.capacity() + grid_->rowProportions.capacity() +
+                               grid_->columnOffsets.capacity() + grid_->rowOffsets.capacity()) * sizeof(float);
+    }
+    if (expressions_) {
+        report.layoutBytes += sizeof(*expressions_);
+        for (auto& expression: *expressions_) {
+            report.layoutBytes += expression ? expression->getMemoryUsage() : 0;
+        }
+    }
+
+    if (backgroundShape_) {
+        report.renderBytes += sizeof(sf::RectangleShape);
+    }
+    if (decoration_) {
+        report.renderBytes += sizeof(Decoration);
+    }
+    if (style_) {
+        size_t styleBytes = sizeof(Style) + style_->users_.capacity() * sizeof(ContainerHandle);
+        report.renderBytes += styleBytes / static_cast<size_t>(style_.use_count());
+    }
+    if (styleOverrides_) {
+        report.renderBytes += sizeof(Style);
+    }
+    if (animationState_) {
+        report.renderBytes += sizeof(AnimationState);
+    }
+
+    if (layer_) {
+        report.cacheBytes += sizeof(Layer) + layer_->memoryUsage;
+    }
+    if (batch_) {
+        report.cacheBytes += sizeof(Batch) + batch_->vertices.capacity() * sizeof(sf::Vertex) +
+                             batch_->buffer.getVertexCount() * sizeof(sf::Vertex) +
+                             batch_->separateElements.capacity() * sizeof(batch_->separateElements[0]);
+    }
+
+    for (auto& element: elements_) {
+        std::visit([&report](auto& el) { el->collectMemoryUsage(report); }, element);
+    }
+}
+
+// ___________________________________________________________________________
+// Could make this function templated.
+// ___________________________________________________________________________
+ContainerHandle Container::findContainer(const std::string &name) {
+    // Counter to store the number of fits for a wrong type. Used for error messages
+    size_t wrongTypeFits = 0;
+
+    for (auto& element : elements_) {
+        // Using std::visit to get the name
+        auto elementName = std::visit([](auto& el) -> const std::string& { return el->getName(); }, element);
+
+        // Check if the element's name matches
+        if (elementName == name) {
+            // Check if the type matches as well
+            if (auto containerPtr = std::get_if<std::unique_ptr<Container>>(&element)) {
+                return (*containerPtr)->getHandle();
+            } else {
+                wrongTypeFits++;
+            }
+        }
+    }
+
+    if (wrongTypeFits > 0) {
+        throw std::runtime_error("Name found but type mismatch.");
+    } else {
+        throw std::runtime_error("No matching name found.");
+    }
+}
+
+// ___________________________________________________________________________
+UIComponentHandle Container::findUIComponent(const std::string &name) {
+    // Counter to store the number of fits for a wrong type. Used for error messages
+    size_t wrongTypeFits = 0;
+
+    for (auto& element : elements_) {
+        // Using std::visit to get the name
+        auto elementName = std::visit([](auto& el) -> const std::string& { return el->getName(); }, element);
+
+        // Check if the element's name matches
+        if (elementName == name) {
+            // Check if the type matches as well
+            if (auto componentPtr = std::get_if<std::unique_ptr<UIComponent>>(&element)) {
+                return (*componentPtr)->getHandle();
+            } else {
+                wrongTypeFits++;
+            }
+        }
+    }
+
+    if (wrongTypeFits > 0) {
+        throw std::runtime_error("Name found but type mismatch.");
+    } else {
+        throw std::runtime_error("No matching name found.");
+    }
+}
+
+// ___________________________________________________________________________
+Container &Container::getContainer(const std::string &name) {
+    // The handle of a found element always resolves
+    return *resolve(findContainer(name));
+}
+
+// ___________________________________________________________________________
+UIComponent &Container::getUIComponent(const std::string &name) {
+    // The handle of a found element always resolves
+    return *UIComponent::resolve(findUIComponent(name));
+}
+
+// ___________________________________________________________________________
+// Could also make these functions templated.
+// ___________________________________________________________________________
+void Container::addContainer(std::unique_ptr<Container> container) {
+    // Place the container automatically if the layout is a grid
+    addContainer(std::move(container), GridCell());
+}
+
+// ___________________________________________________________________________
+void Container::addUIComponent(std::unique_ptr<UIComponent> component) {
+    // Place the component automatically if the layout is a grid
+    addUIComponent(std::move(component), GridCell());
+}
+
+// ___________________________________________________________________________
+void Container::addContainer(std::unique_ptr<Container> container, GridCell cell) {
+    // Construct the container at the end of elements_
+    insertElement(std::move(container), cell, elements_.size());
+}
+
+// ___________________________________________________________________________
+void Container::addUIComponent(std::unique_ptr<UIComponent> component, GridCell cell) {
+    // Construct the component at the end of elements_
+    insertElement(std::move(component), cell, elements_.size());
+}
+
+// ___________________________________________________________________________
+// Assume that unique names within containers are guaranteed
+// ___________________________________________________________________________
+void Container::removeContainer(const std::string &name) {
+    removeContainer(findContainer(name));
+}
+
+// ___________________________________________________________________________
+void Container::removeUIComponent(const std::string &name) {
+    removeUIComponent(findUIComponent(name));
+}
+
+// ___________________________________________________________________________
+void Container::removeContainer(ContainerHandle handle) {
+    // Detach the container and let it be destroyed
+    detachContainer(handle);
+}
+
+// ___________________________________________________________________________
+void Container::removeUIComponent(UIComponentHandle handle) {
+    // Detach the component and let it be destroyed
+    detachUIComponent(handle);
+}
+
+// ___________________________________________________________________________
+std::unique_ptr<Container> Container::detachContainer(ContainerHandle handle) {
+    size_t index = findElementIndex(resolve(handle));
+
+    // Check if the handle refers to a nested container
+    if (index == elements_.size()) {
+        throw std::runtime_error("No matching container found.");
+    }
+
+    return std::get<std::unique_ptr<Container>>(detachElement(index));
+}
+
+// ___________________________________________________________________________
+std::unique_ptr<UIComponent> Container::detachUIComponent(UIComponentHandle handle) {
+    size_t index = findElementIndex(UIComponent::resolve(handle));
+
+    // Check if the handle refers to a nested UI component
+    if (index == elements_.size()) {
+        throw std::runtime_error("No matching UI component found.");
+    }
+
+    return std::get<std::unique_ptr<UIComponent>>(detachElement(index));
+}
+
+// ___________________________________________________________________________
+void Container::moveElement(ContainerHandle element, size_t index) {
+    moveElement(findElementIndex(resolve(element)), index);
+}
+
+// ___________________________________________________________________________
+void Container::moveElement(UIComponentHandle element, size_t index) {
+    moveElement(findElementIndex(UIComponent::resolve(element)), index);
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Check that the order is a permutation of the current indices
+ * - Build the reordered vectors by moving the elements and their grid placements, so nothing is reallocated per
+ * element and the nested elements keep their cached layout
+ * - Update this container once
+ */
+// ___________________________________________________________________________
+void Container::reorderElements(const std::vector<size_t> &order) {
+    // Check that every current index appears exactly once
+    std::vector<bool> isUsed(elements_.size(), false);
+    bool isPermutation = order.size() == elements_.size();
+    for (size_t index = 0; isPermutation and index < order.size(); index++) {
+        isPermutation = order[index] < elements_.size() and !isUsed[order[index]];
+        if (isPermutation) {
+            isUsed[order[index]] = true;
+        }
+    }
+    if (!isPermutation) {
+        throw std::runtime_error("Order isn't a permutation of the element indices.");
+    }
+
+    std::vector<ElementType> elements;
+    elements.reserve(elements_.size());
+    for (size_t index: order) {
+        elements.push_back(std::move(elements_[index]));
+    }
+    elements_ = std::move(elements);
+    updateElementIndices(0, elements_.size());
+
+    if (grid_) {
+        std::vector<GridPlacement> placements;
+        placements.reserve(grid_->placements.size());
+        for (size_t index: order) {
+            placements.push_back(grid_->placements[index]);
+        }
+        grid_->placements = std::move(placements);
+    }
+
+    // The focus chain follows the layout order
+    if (subtreeCallbackMask_ & focusableMask) {
+        if (FocusManager* focusManager = getFocusManager()) {
+            focusManager->updateSubtree(*this);
+        }
+    }
+
+    // Update grid and render update flags
+    needGridUpdate_ = true;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void Container::reparentElement(ContainerHandle element, Container &newParent, size_t index) {
+    Container* container = resolve(element);
+
+    // A container can't be moved into its own subtree
+    for (Container* ancestor = &newParent; ancestor; ancestor = ancestor->parent_) {
+        if (ancestor == container) {
+            throw std::runtime_error("Container can't be moved into its own subtree.");
+        }
+    }
+
+    if (&newParent == this) {
+        moveElement(element, index);
+    } else {
+        newParent.insertElement(detachContainer(element), GridCell(), index);
+    }
+}
+
+// ___________________________________________________________________________
+void Container::reparentElement(UIComponentHandle element, Container &newParent, size_t index) {
+    if (&newParent == this) {
+        moveElement(element, index);
+    } else {
+        newParent.insertElement(detachUIComponent(element), GridCell(), index);
+    }
+}
+
+// ___________________________________________________________________________
+size_t Container::findElementIndex(const Container *element) const {
+    // The element stores its index, so only check that it's actually nested here
+    if (element and element->parent_ == this and element->indexInParent_ < elements_.size()) {
+        auto* nested = std::get_if<std::unique_ptr<Container>>(&elements_[element->indexInParent_]);
+        if (nested and nested->get() == element) {
+            return element->indexInParent_;
+        }
+    }
+    return elements_.size();
+}
+
+// ___________________________________________________________________________
+size_t Container::findElementIndex(const UIComponent *element) const {
+    // The element stores its index, so only check that it's actually nested here
+    if (element and element->parent_ == this and element->indexInParent_ < elements_.size()) {
+        auto* nested = std::get_if<std::unique_ptr<UIComponent>>(&elements_[element->indexInParent_]);
+        if (nested and nested->get() == element) {
+            return element->indexInParent_;
+        }
+    }
+    return elements_.size();
+}
+
+// ___________________________________________________________________________
+void Container::updateElementIndices(size_t first, size_t last) {
+    for (size_t index = first; index < last; index++) {
+        std::visit([index](auto& el) { el->indexInParent_ = index; }, elements_[index]);
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Insert the element and its grid placement at the same index. Without grid state, the placement is only stored
+ * if the element has a cell, which creates the grid state
+ * - Inside a batch, only the flags are set. Sizes, callback masks and layers are updated once on commit
+ * - Elements that already have been laid out keep their layout. In grid layouts, the grid pass assigns the parent
+ * size. Otherwise, it's set here, which only recomputes a container's size if it actually changed
+ * - Include the element's callbacks without revisiting the other elements and update this container
+ * - Link focusable components into the focus chain. Inside a batch, this happens on commit
+ */
+// ___________________________________________________________________________
+void Container::insertElement(ElementType element, GridCell cell, size_t index) {
+    index = std::min(index, elements_.size());
+    bool isBatching = this->isBatching();
+
+    std::visit([this, isBatching](auto& el) {
+        el->setParent(this);
+        if (not isBatching and layoutOrientation_ != LayoutOrientation::Grid) {
+            el->setParentSize(size_);
+        }
+    }, element);
+
+    unsigned callbackMask = std::visit([](auto& el) -> unsigned { return el->getCallbackMask(); }, element);
+
+    // Containers depending on their siblings are updated once the element is inserted
+    if (auto* container = std::get_if<std::unique_ptr<Container>>(&element)) {
+        if ((*container)->expressionInputMask_ & toInputMask(ExpressionInput::Sibling)) {
+            hasSiblingExpressions_ = true;
+        }
+    }
+
+    elements_.insert(elements_.begin() + static_cast<std::ptrdiff_t>(index), std::move(element));
+    updateElementIndices(index, elements_.size());
+    if (grid_) {
+        grid_->placements.insert(grid_->placements.begin() + static_cast<std::ptrdiff_t>(index), {cell});
+    } else if (cell.row >= 0 or cell.column >= 0 or cell.rowSpan != 1 or cell.columnSpan != 1) {
+        getGridState().placements[index].cell = cell;
+    }
+
+    // Update grid and render update flags
+    needGridUpdate_ = true;
+    if (isBatching) {
+        needRenderUpdate_ = true;
+        return;
+    }
+
+    // Include the callbacks of the new subtree
+    addToCallbackMask(callbackMask);
+    requestRenderUpdate();
+
+    // The new element might be referenced by its siblings or reference them itself
+    if (layoutOrientation_ != LayoutOrientation::Grid) {
+        updateSiblingExpressions();
+    }
+
+    if (callbackMask & focusableMask) {
+        if (FocusManager* focusManager = getFocusManager()) {
+            focusManager->addElement(*this, index);
+        }
+    }
+}
+
+// ___________________________________________________________________________
+Container::ElementType Container::detachElement(size_t index) {
+    // Unlink the element's focusable components while it's still part of the tree
+    if (std::visit([](auto& el) -> unsigned { return el->getCallbackMask(); }, elements_[index]) & focusableMask) {
+        if (FocusManager* focusManager = getFocusManager()) {
+            focusManager->removeElement(*this, index);
+        }
+    }
+
+    // Take the element out and remove it and its grid placement
+    ElementType element = std::move(elements_[index]);
+    elements_.erase(elements_.begin() + static_cast<std::ptrdiff_t>(index));
+    updateElementIndices(index, elements_.size());
+    if (grid_) {
+        grid_->placements.erase(grid_->placements.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+
+    std::visit([](auto& el) { el->setParent(nullptr); }, element);
+
+    // Update grid and render update flags and drop the callbacks of the removed element
+    needGridUpdate_ = true;
+    requestRenderUpdate();
+    updateCallbackMask();
+
+    return element;
+}
+
+// ___________________________________________________________________________
+void Container::moveElement(size_t from, size_t to) {
+    // Check if the element is nested in this container
+    if (from >= elements_.size()) {
+        throw std::runtime_error("No matching element found.");
+    }
+    to = std::min(to, elements_.size() - 1);
+
+    // Rotate the range between both indices. Only the elements in between are shifted by one
+    if (from < to) {
+        std::rotate(elements_.begin() + from, elements_.begin() + from + 1, elements_.begin() + to + 1);
+        if (grid_) {
+            auto placements = grid_->placements.begin();
+            std::rotate(placements + from, placements + from + 1, placements + to + 1);
+        }
+    } else if (to < from) {
+        std::rotate(elements_.begin() + to, elements_.begin() + from, elements_.begin() + from + 1);
+        if (grid_) {
+            auto placements = grid_->placements.begin();
+            std::rotate(placements + to, placements + from, placements + from + 1);
+        }
+    } else {
+        return;
+    }
+    updateElementIndices(std::min(from, to), std::max(from, to) + 1);
+
+    // The focus chain follows the layout order
+    if (std::visit([](auto& el) -> unsigned { return el->getCallbackMask(); }, elements_[to]) & focusableMask) {
+        if (FocusManager* focusManager = getFocusManager()) {
+            focusManager->moveElement(*this, to);
+        }
+    }
+
+    // Update grid and render update flags
+    needGridUpdate_ = true;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+bool Container::isBatching() const {
+    for (const Container* container = this; container; container = container->parent_) {
+        if (container->batchDepth_ > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Compute the own dimensions from the parent size, which has been set by the parent's pass
+ * - Resolve the grid tracks right away, so that the elements of a grid get their cell size in this pass as well and
+ * the grid layout pass doesn't resize them again
+ * - Pass the parent size on to all elements and measure nested containers recursively
+ * - Collect the callback masks bottom-up on the way back
+ */
+// ___________________________________________________________________________
+void Container::measureSubtree() {
+    computeDimensions(allExpressionInputs);
+
+    if (layoutOrientation_ == LayoutOrientation::Grid) {
+        computeGridTracks();
+    }
+
+    subtreeCallbackMask_ = callbackMask_;
+    for (size_t index = 0; index < elements_.size(); index++) {
+        sf::Vector2f elementParentSize = size_;
+        if (layoutOrientation_ == LayoutOrientation::Grid) {
+            sf::FloatRect cellBounds = getGridCellBounds(grid_->placements[index]);
+            elementParentSize = sf::Vector2f(cellBounds.width, cellBounds.height);
+            grid_->placements[index].cellSize = elementParentSize;
+        }
+
+        if (auto* container = std::get_if<std::unique_ptr<Container>>(&elements_[index])) {
+            (*container)->parentSize_ = elementParentSize;
+            (*container)->measureSubtree();
+            subtreeCallbackMask_ |= (*container)->getCallbackMask();
+        } else {
+            auto& component = std::get<std::unique_ptr<UIComponent>>(elements_[index]);
+            component->setParentSize(elementParentSize);
+            subtreeCallbackMask_ |= component->getCallbackMask();
+        }
+    }
+
+    // All siblings are measured now
+    if (layoutOrientation_ != LayoutOrientation::Grid) {
+        updateSiblingExpressions();
+    }
+
+    // The caller invalidates the layers and batches above the measured subtree, the ones inside are invalidated here
+    needRenderUpdate_ = true;
+    if (layer_) {
+        layer_->isValid = false;
+    }
+    if (batch_) {
+        batch_->isValid = false;
+    }
+}
+
+// ___________________________________________________________________________
+void Container::addToCallbackMask(unsigned callbackMask) {
+    // Only walk further up if new callback types have been added
+    if ((callbackMask & ~subtreeCallbackMask_) != 0) {
+        subtreeCallbackMask_ |= callbackMask;
+        if (parent_) {
+            parent_->addToCallbackMask(callbackMask);
+        }
+    }
+}
+
+// ___________________________________________________________________________
+void Container::reserve(size_t elementCount) {
+    elements_.reserve(elementCount);
+    if (grid_) {
+        grid_->placements.reserve(elementCount);
+    }
+}
+
+// ___________________________________________________________________________
+void Container::beginBatch() {
+    batchDepth_++;
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Only the outermost commit runs the passes. If a parent container still has an open batch, its commit covers
+ * this subtree as well
+ * - Measure the whole subtree once, then pass the new callback types on to the parents and invalidate the layers
+ * containing this container once
+ * - Link the focusable components added during the batch into the focus chain
+ * - Arrange the whole subtree once
+ */
+// ___________________________________________________________________________
+void Container::commitBatch() {
+    if (batchDepth_ == 0) {
+        std::cerr << "Container '" << name_ << "' has no open batch to commit." << std::endl;
+        return;
+    }
+    if (--batchDepth_ > 0 or isBatching()) {
+        return;
+    }
+
+    measureSubtree();
+    if (parent_) {
+        parent_->updateCallbackMask();
+    }
+    requestRenderUpdate();
+
+    if (FocusManager* focusManager = getFocusManager()) {
+        focusManager->updateSubtree(*this);
+    }
+
+    updateLayout();
+}
+
+// ___________________________________________________________________________
+void Container::updateLayout() {
+    if (needRenderUpdate_) {
+        computeRenderInformation();
+    }
+
+    // The nested elements are positioned now and can compute their own layout
+    for (auto& element: elements_) {
+        std::visit([](auto& el) { el->updateLayout(); }, element);
+    }
+}
+
+// ___________________________________________________________________________
+void Container::updateGeometry() {
+    if (needRenderUpdate_) {
+        computeRenderInformation();
+    }
+
+    for (auto& element: elements_) {
+        if (auto* container = std::get_if<std::unique_ptr<Container>>(&element)) {
+            (*container)->updateGeometry();
+        }
+    }
+}
+
+// ___________________________________________________________________________
+void Container::draw(sf::RenderTarget &target, sf::RenderStates states) {
+    // Check for render updates using the render update flag
+    if (needRenderUpdate_) {
+        computeRenderInformation();
+    }
+
+    // Apply the animated offset and scale as a transform. The scale is relative to the container's center. This
+    // doesn't touch the layout, so nothing has to be recomputed while animating.
+    if (animationState_) {
+        sf::Vector2f center = position_ + size_ / 2.f;
+        states.transform.translate(animationState_->offset + center).scale(animationState_->scale).translate(-center);
+    }
+
+    if (cacheAsLayer_) {
+        drawLayer(target, states);
+    } else if (batch_) {
+        drawBatch(target, states);
+    } else {
+        drawContent(target, states, animationState_ ? animationState_->opacity : 1);
+    }
+}
+
+// ___________________________________________________________________________
+void Container::drawContent(sf::RenderTarget &target, const sf::RenderStates &states, float opacity) {
+    drawBackground(target, states, opacity);
+
+    // Loop over all elements and call their respective draw functions. Containers update their own render
+    // information when drawn, UI components are updated here
+    for (auto& element : elements_) {
+        if (auto* component = std::get_if<std::unique_ptr<UIComponent>>(&element)) {
+            (*component)->updateLayout();
+        }
+        std::visit([&target, &states](auto& el) { el->draw(target, states); }, element);
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Plain backgrounds are drawn from the rectangle shape, temporarily applying the animated colors
+ * - Decorated backgrounds are drawn from the same vertices as in a batch. The vertex vector is reused between calls
+ * to avoid allocating in every frame
+ */
+// ___________________________________________________________________________
+void Container::drawBackground(sf::RenderTarget &target, const sf::RenderStates &states, float opacity) {
+    if (not isVisible_ or (!backgroundShape_ and !decoration_)) {
+        return;
+    }
+
+    if (decoration_) {
+        static std::vector<sf::Vertex> vertices;
+        vertices.clear();
+
+        sf::RenderStates shapeStates = states;
+        shapeStates.shader = getShapeShader();
+        appendBackgroundVertices(vertices, shapeStates.shader != nullptr, opacity);
+        if (!vertices.empty()) {
+            target.draw(vertices.data(), vertices.size(), sf::Triangles, shapeStates);
+        }
+    } else if (animationState_) {
+        // Temporarily apply the animated colors and restore the set ones afterward
+        sf::Color fillColor = backgroundShape_->getFillColor();
+        sf::Color outlineColor = backgroundShape_->getOutlineColor();
+
+        sf::Color animatedFillColor = animationState_->hasBackgroundColor ? animationState_->backgroundColor
+                                                                          : fillColor;
+        sf::Color animatedOutlineColor = outlineColor;
+        animatedFillColor.a = static_cast<sf::Uint8>(animatedFillColor.a * opacity);
+        animatedOutlineColor.a = static_cast<sf::Uint8>(animatedOutlineColor.a * opacity);
+
+        backgroundShape_->setFillColor(animatedFillColor);
+        backgroundShape_->setOutlineColor(animatedOutlineColor);
+        target.draw(*backgroundShape_, states);
+        backgroundShape_->setFillColor(fillColor);
+        backgroundShape_->setOutlineColor(outlineColor);
+    } else {
+        target.draw(*backgroundShape_, states);
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - The layer covers the container's bounds plus the outline and the shadow, which are drawn outside the bounds
+ * - Recreate the texture if the size changed. If that fails, e.g., for an empty size or at the memory limit, draw
+ * directly. The layer is kept enabled, but only retried once the size changes, so that a failure isn't repeated
+ * every frame
+ * - Redraw the content into the texture only if the layer is outdated. Nested elements may update their layout
+ * while being drawn, so the layer is marked as up to date only afterward
+ * - Draw the texture as a single quad, applying the parents' and the own animated transforms and the opacity
+ */
+// ___________________________________________________________________________
+void Container::drawLayer(sf::RenderTarget &target, const sf::RenderStates &states) {
+    float opacity = animationState_ ? animationState_->opacity : 1;
+
+    float margin = backgroundShape_ ? std::max(0.f, backgroundShape_->getOutlineThickness()) : 0;
+    if (decoration_) {
+        // Antialiased edges reach a pixel further, shadows their offset and half the blur
+        const Shadow& shadow = decoration_->shadow;
+        float shadowMargin = shadow.color.a > 0 ? std::max(std::abs(shadow.offset.x), std::abs(shadow.offset.y)) +
+                                                  shadow.blur / 2 : 0;
+        margin = std::max(margin, shadowMargin) + 1;
+    }
+    sf::Vector2f layerPosition = position_ - sf::Vector2f(margin, margin);
+    sf::Vector2u textureSize(static_cast<unsigned>(std::ceil(size_.x + 2 * margin)),
+                             static_cast<unsigned>(std::ceil(size_.y + 2 * margin)));
+
+    if (!layer_ or layer_->texture.getSize() != textureSize) {
+        if (failedLayerSize_ == textureSize or !createLayer(textureSize)) {
+            // Draw the container directly until the layer can be created for a new size
+            failedLayerSize_ = textureSize;
+            drawContent(target, states, opacity);
+            return;
+        }
+        failedLayerSize_.reset();
+    }
+
+    if (!layer_->isValid) {
+        // Map the container's bounds onto the texture, so that the content can be drawn at its absolute position
+        layer_->texture.setView(sf::View(sf::FloatRect(layerPosition.x, layerPosition.y,
+                                                       static_cast<float>(textureSize.x),
+                                                       static_cast<float>(textureSize.y))));
+        layer_->texture.clear(sf::Color::Transparent);
+        drawContent(layer_->texture, sf::RenderStates::Default, 1);
+        layer_->texture.display();
+
+        layer_->isValid = true;
+    }
+
+    sf::Sprite sprite(layer_->texture.getTexture());
+    sprite.setPosition(layerPosition);
+    sprite.setColor(sf::Color(255, 255, 255, static_cast<sf::Uint8>(255 * opacity)));
+    target.draw(sprite, states);
+}
+
+// ___________________________________________________________________________
+bool Container::createLayer(sf::Vector2u textureSize) {
+    releaseLayer();
+
+    size_t memoryUsage = static_cast<size_t>(textureSize.x) * textureSize.y * 4;
+
+    // Check the size and the memory limit
+    if (textureSize.x == 0 or textureSize.y == 0 or textureSize.x > sf::Texture::getMaximumSize() or
+        textureSize.y > sf::Texture::getMaximumSize()) {
+        return false;
+    }
+    if (layerMemoryUsage_ + memoryUsage > layerMemoryLimit_) {
+        std::cerr << "Container '" << name_ << "' can't be cached as a layer. The layer memory limit of "
+                  << layerMemoryLimit_ << " bytes would be exceeded." << std::endl;
+        return false;
+    }
+
+    auto layer = std::make_unique<Layer>();
+    if (!layer->texture.create(textureSize.x, textureSize.y)) {
+        std::cerr << "Container '" << name_ << "' couldn't create its layer texture." << std::endl;
+        return false;
+    }
+
+    layer->memoryUsage = memoryUsage;
+    layerMemoryUsage_ += memoryUsage;
+    layer_ = std::move(layer);
+    return true;
 }
 
 // ___________________________________________________________________________
-const bool &Container::isEnabled() const {
-    return isEnabled_;
+void Container::releaseLayer() {
+    if (layer_) {
+        layerMemoryUsage_ -= layer_->memoryUsage;
+        layer_ = nullptr;
+    }
 }
 
 // ___________________________________________________________________________
-// Could make this function templated.
+/*
+ * Function logic walk-through:
+ * - Rebuild an outdated batch: collect the geometry, then upload it. Batches rebuilt after only a few draws are
+ * uploaded into a streaming buffer, the others into a static one. The batch is marked as up to date before the
+ * separate elements are drawn, so that changes made while drawing them cause a rebuild in the next frame
+ * - Draw the own background separately if it's animated, then the batched geometry in one call, then the separate
+ * elements in their order in the tree
+ * - Without vertex buffer support, the geometry is drawn from client memory, which is still a single draw call
+ * - The geometry is encoded for the shape shader if it is available, so that the batch can be drawn with it
+ */
 // ___________________________________________________________________________
-Container &Container::getContainer(const std::string &name) {
-    // Counter to store the number of fits for a wrong type. Used for error messages
-    size_t wrongTypeFits = 0;
+void Container::drawBatch(sf::RenderTarget &target, const sf::RenderStates &states) {
+    Batch& batch = *batch_;
+
+    if (!batch.isValid) {
+        batch.vertices.clear();
+        batch.separateElements.clear();
+        batch.shader = getShapeShader();
+        collectBatch(batch);
+
+        if (sf::VertexBuffer::isAvailable() and !batch.vertices.empty()) {
+            batch.buffer.setUsage(batch.drawsSinceUpload < staticBatchMinDraws ? sf::VertexBuffer::Stream
+                                                                               : sf::VertexBuffer::Static);
+            if (batch.buffer.getVertexCount() == 0) {
+                batch.buffer.create(batch.vertices.size());
+            }
+            batch.buffer.update(batch.vertices.data(), batch.vertices.size(), 0);
 
-    for (auto& element : elements_) {
-        // Using std::visit to get the name
-        auto elementName = std::visit([](auto& el) -> const std::string& { return el->getName(); }, element);
+            batchStatistics_.uploads++;
+            batchStatistics_.uploadedBytes += batch.vertices.size() * sizeof(sf::Vertex);
+        }
 
-        // Check if the element's name matches
-        if (elementName == name) {
-            // Check if the type matches as well
-            if (auto containerPtr = std::get_if<std::unique_ptr<Container>>(&element)) {
-                return **containerPtr;
-            } else {
-                wrongTypeFits++;
-            }
+        batch.drawsSinceUpload = 0;
+        batch.isValid = true;
+    }
+
+    if (animationState_) {
+        drawBackground(target, states, animationState_->opacity);
+    }
+
+    if (!batch.vertices.empty()) {
+        sf::RenderStates batchStates = states;
+        batchStates.shader = batch.shader;
+        if (sf::VertexBuffer::isAvailable()) {
+            target.draw(batch.buffer, 0, batch.vertices.size(), batchStates);
+        } else {
+            target.draw(batch.vertices.data(), batch.vertices.size(), sf::Triangles, batchStates);
         }
     }
+    batch.drawsSinceUpload++;
+    batchStatistics_.draws++;
 
-    if (wrongTypeFits > 0) {
-        throw std::runtime_error("Name found but type mismatch.");
-    } else {
-        throw std::runtime_error("No matching name found.");
+    for (auto& element: batch.separateElements) {
+        if (auto* component = std::get_if<UIComponent*>(&element)) {
+            (*component)->updateLayout();
+        }
+        std::visit([&target, &states](auto* el) { el->draw(target, states); }, element);
     }
 }
 
 // ___________________________________________________________________________
-UIComponent &Container::getUIComponent(const std::string &name) {
-    // Counter to store the number of fits for a wrong type. Used for error messages
-    size_t wrongTypeFits = 0;
+void Container::collectBatch(Batch &batch) {
+    // Batched containers aren't drawn individually, so their layout is updated here, before the nested elements
+    if (needRenderUpdate_) {
+        computeRenderInformation();
+    }
 
-    for (auto& element : elements_) {
-        // Using std::visit to get the name
-        auto elementName = std::visit([](auto& el) -> const std::string& { return el->getName(); }, element);
+    // The background of an animated batch root is drawn separately with its animated colors
+    if (!animationState_) {
+        appendBackgroundVertices(batch.vertices, batch.shader != nullptr, 1);
+    }
 
-        // Check if the element's name matches
-        if (elementName == name) {
-            // Check if the type matches as well
-            if (auto containerPtr = std::get_if<std::unique_ptr<UIComponent>>(&element)) {
-                return **containerPtr;
+    for (auto& element: elements_) {
+        if (auto* container = std::get_if<std::unique_ptr<Container>>(&element)) {
+            Container& nested = **container;
+            if (nested.animationState_ or nested.cacheAsLayer_ or nested.batch_) {
+                batch.separateElements.emplace_back(&nested);
             } else {
-                wrongTypeFits++;
+                nested.collectBatch(batch);
             }
+        } else {
+            batch.separateElements.emplace_back(std::get<std::unique_ptr<UIComponent>>(element).get());
         }
     }
-
-    if (wrongTypeFits > 0) {
-        throw std::runtime_error("Name found but type mismatch.");
-    } else {
-        throw std::runtime_error("No matching name found.");
-    }
 }
 
 // ___________________________________________________________________________
-// Could also make these functions templated.
+/*
+ * Function logic walk-through:
+ * - Match the rectangle shape: the fill covers the bounds and the outline is a ring outside the bounds for positive
+ * thickness and inside for negative thickness, drawn on top of the fill. The shadow is drawn first, beneath both
+ * - Sharp corners are plain rectangles, and the outline is made of four strips between its outer and inner
+ * rectangle. Rounded corners are rounded rectangles. A positive outline grows the radius along with the bounds, so
+ * that its inner edge follows the fill. An inside outline can't be thicker than the radius, so the radius of the
+ * whole background grows with a thicker one
+ * - Shadows keep the radius, grown by half the blur so that blurred sharp corners look rounded. Fully transparent
+ * parts are skipped
+ */
 // ___________________________________________________________________________
-void Container::addContainer(std::unique_ptr<Container> container) {
-    // Using emplace_back and std::move to construct the container at the end of elements_
-    elements_.emplace_back(std::move(container));
+void Container::appendBackgroundVertices(std::vector<sf::Vertex> &vertices, bool useShader, float opacity) const {
+    if (not isVisible_ or (!backgroundShape_ and !decoration_)) {
+        return;
+    }
 
-    // Update render update flag
-    needRenderUpdate_ = true;
-}
+    auto fade = [opacity](sf::Color color) {
+        color.a = static_cast<sf::Uint8>(color.a * opacity);
+        return color;
+    };
 
-// ___________________________________________________________________________
-void Container::addUIComponent(std::unique_ptr<UIComponent> component) {
-    // Using emplace_back and std::move to construct the container at the end of elements_
-    elements_.emplace_back(std::move(component));
+    sf::FloatRect bounds(position_, size_);
+    float radius = decoration_ ? std::max(0.f, decoration_->cornerRadius) : 0;
+    if (radius >= 1 and backgroundShape_ and backgroundShape_->getOutlineThickness() < 0) {
+        radius = std::max(radius, -backgroundShape_->getOutlineThickness());
+    }
 
-    // Update render update flag
-    needRenderUpdate_ = true;
-}
+    if (decoration_ and decoration_->shadow.color.a > 0) {
+        const Shadow& shadow = decoration_->shadow;
+        sf::FloatRect shadowBounds(bounds.left + shadow.offset.x, bounds.top + shadow.offset.y,
+                                   bounds.width, bounds.height);
+        float blur = shadow.blur >= 1 ? shadow.blur : 0;
+        if (radius + blur < 1) {
+            appendRectangle(vertices, shadowBounds, fade(shadow.color));
+        } else {
+            appendRoundedRectangle(vertices, shadowBounds, radius + blur / 2, fade(shadow.color), 0, blur, useShader);
+        }
+    }
 
-// ___________________________________________________________________________
-// Assume that unique names within containers are guaranteed
-// ___________________________________________________________________________
-void Container::removeContainer(const std::string &name) {
-    for (auto it = elements_.begin(); it != elements_.end(); ++it) {
-        // Use std::visit to get the name of the element
-        auto elementName = std::visit([](auto& el) -> const std::string& { return el->getName(); }, *it);
+    if (!backgroundShape_) {
+        return;
+    }
 
-        // Check if the element's name matches the given name
-        if (elementName == name) {
-            // Check if the element is of type std::unique_ptr<Container>
-            if (std::holds_alternative<std::unique_ptr<Container>>(*it)) {
-                // Remove the element
-                elements_.erase(it);
+    sf::Color fillColor = backgroundShape_->getFillColor();
+    if (animationState_ and animationState_->hasBackgroundColor) {
+        fillColor = animationState_->backgroundColor;
+    }
+    fillColor = fade(fillColor);
+    if (fillColor.a > 0) {
+        if (radius < 1) {
+            appendRectangle(vertices, bounds, fillColor);
+        } else {
+            appendRoundedRectangle(vertices, bounds, radius, fillColor, 0, 0, useShader);
+        }
+    }
 
-                // Update render update flag
-                needRenderUpdate_ = true;
+    float thickness = backgroundShape_->getOutlineThickness();
+    sf::Color outlineColor = fade(backgroundShape_->getOutlineColor());
+    if (thickness == 0 or outlineColor.a == 0) {
+        return;
+    }
 
-                // Exit the function after removing the element
-                return;
-            } else {
-                // Here the unique name assumption is made
-                throw std::runtime_error("Name found but type mismatch.");
-            }
-        }
+    float width = std::abs(thickness);
+    sf::FloatRect outer = thickness > 0 ? sf::FloatRect(bounds.left - width, bounds.top - width,
+                                                        bounds.width + 2 * width, bounds.height + 2 * width)
+                                        : bounds;
+
+    if (radius >= 1) {
+        float outerRadius = thickness > 0 ? radius + width : radius;
+        appendRoundedRectangle(vertices, outer, outerRadius, outlineColor, width, 0, useShader);
+        return;
     }
-    // If no matching name is found
-    throw std::runtime_error("No matching name found.");
+
+    sf::FloatRect inner(outer.left + width, outer.top + width, outer.width - 2 * width, outer.height - 2 * width);
+    appendRectangle(vertices, sf::FloatRect(outer.left, outer.top, outer.width, width), outlineColor);
+    appendRectangle(vertices, sf::FloatRect(outer.left, inner.top + inner.height, outer.width, width), outlineColor);
+    appendRectangle(vertices, sf::FloatRect(outer.left, inner.top, width, inner.height), outlineColor);
+    appendRectangle(vertices, sf::FloatRect(inner.left + inner.width, inner.top, width, inner.height), outlineColor);
 }
 
 // ___________________________________________________________________________
-void Container::removeUIComponent(const std::string &name) {
-    for (auto it = elements_.begin(); it != elements_.end(); ++it) {
-        // Use std::visit to get the name of the element
-        auto elementName = std::visit([](auto& el) -> const std::string& { return el->getName(); }, *it);
-
-        // Check if the element's name matches the given name
-        if (elementName == name) {
-            // Check if the element is of type std::unique_ptr<Container>
-            if (std::holds_alternative<std::unique_ptr<UIComponent>>(*it)) {
-                // Remove the element
-                elements_.erase(it);
-
-                // Update render update flag
-                needRenderUpdate_ = true;
+void Container::requestRenderUpdate() {
+    needRenderUpdate_ = true;
+    invalidateLayers();
+}
 
-                // Exit the function after removing the element
-                return;
-            } else {
-                // Here the unique name assumption is made
-                throw std::runtime_error("Name found but type mismatch.");
-            }
-        }
+// ___________________________________________________________________________
+sf::RectangleShape &Container::getBackgroundShape() {
+    // Create a background shape instance if it doesn't exist yet. Its geometry is otherwise only updated with the
+    // render information, which might be up to date already
+    if (!backgroundShape_) {
+        backgroundShape_ = std::make_unique<sf::RectangleShape>(size_);
+        backgroundShape_->setPosition(position_);
     }
-    // If no matching name is found
-    throw std::runtime_error("No matching name found.");
+    return *backgroundShape_;
 }
 
 // ___________________________________________________________________________
-void Container::draw(sf::RenderWindow &window) {
-    // Check for render updates using the render update flag
-    if (needRenderUpdate_) {
-        computeRenderInformation();
+Container::Decoration &Container::getDecoration() {
+    if (!decoration_) {
+        decoration_ = std::make_unique<Decoration>();
     }
+    return *decoration_;
+}
 
-    // Check for background and outline drawing instructions and draw them if applicable. Could add additional
-    // checks here like outlineColor == backgroundColor, outlineThickness == 0, and more.
-    if (backgroundShape_ and isVisible_) {
-        window.draw(*backgroundShape_);
+// ___________________________________________________________________________
+Container::GridState &Container::getGridState() {
+    if (!grid_) {
+        grid_ = std::make_unique<GridState>();
+        grid_->placements.resize(elements_.size());
     }
+    return *grid_;
+}
 
-    // Loop over all elements and call their respective draw functions
-    for (auto& element : elements_) {
-        std::visit([&window](auto& el) { el->draw(window); }, element);
+// ___________________________________________________________________________
+Style &Container::getStyleOverrides() {
+    // The overrides aren't shared, so they have no users to update
+    if (!styleOverrides_) {
+        styleOverrides_ = std::make_unique<Style>();
     }
+    return *styleOverrides_;
 }
 
 // ___________________________________________________________________________
-// Think of a smarter way and also how cases of, for example, overlapping should be handled. Is there a way to only
-// loop though the elements that have a callback set?
-
-// Could add a feature that checks, for example, in the compute render information function, how many callback
-// components are within a certain container. This could lead to fewer checks necessary in the handleEvent
-// function-cascade
+// Maps an event to the callback type it triggers. Returns false for events that don't trigger any callback.
+// ___________________________________________________________________________
+static bool getCallbackType(const sf::Event& event, CallbackType& type, sf::Vector2f& mousePosition) {
+    switch (event.type) {
+        case sf::Event::MouseButtonPressed:
+            type = CallbackType::Click;
+            mousePosition = sf::Vector2f(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y));
+            return true;
+        case sf::Event::MouseMoved:
+            type = CallbackType::Hover;
+            mousePosition = sf::Vector2f(static_cast<float>(event.mouseMove.x), static_cast<float>(event.mouseMove.y));
+            return true;
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased:
+        case sf::Event::TextEntered:
+            type = CallbackType::Key;
+            return true;
+        default:
+            return false;
+    }
+}
 
+// ___________________________________________________________________________
 // How events should be handled in a container:
 // - Events should propagate through the hierarchy of containers from the top to the bottom
 // - The most specific element should be triggered. Use a flag to indicate if an event has been handled
+// - Only elements with a matching callback somewhere in their subtree are visited. The subtree masks are kept up to
+// date when callbacks are set and elements are added or removed, so the dispatch cost depends on the number of
+// listeners and not on the size of the tree
+// - Mouse events are only passed to elements under the cursor
+// - Events that don't trigger any callback type are still passed to all elements, since UI components may use them
 // ___________________________________________________________________________
 bool Container::handleEvent(sf::Event &event) {
+    // Disabled containers don't react to events
+    if (!isEnabled_) {
+        return false;
+    }
+
+    CallbackType callbackType;
+    sf::Vector2f mousePosition;
+    bool hasCallbackType = getCallbackType(event, callbackType, mousePosition);
+    unsigned eventMask = hasCallbackType ? toCallbackMask(callbackType) : 0;
+
+    // Skip the whole subtree if nothing in it listens to this type of event
+    if (hasCallbackType and !(subtreeCallbackMask_ & eventMask)) {
+        return false;
+    }
+
     bool hasBeenHandled = false;
     // Loop over all other elements and call their handleEvent functions
     for (auto& element: elements_) {
+        if (hasCallbackType) {
+            // Skip elements without listeners for this type of event
+            unsigned elementMask = std::visit([](auto& el) -> unsigned { return el->getCallbackMask(); }, element);
+            if (!(elementMask & eventMask)) {
+                continue;
+            }
+
+            // Skip elements that aren't under the cursor
+            if (callbackType != CallbackType::Key) {
+                sf::FloatRect bounds = std::visit([](auto& el) -> sf::FloatRect {
+                    return {el->getPosition(), el->getSize()};
+                }, element);
+                if (!bounds.contains(mousePosition)) {
+                    continue;
+                }
+            }
+        }
+
         hasBeenHandled = std::visit([&event](auto& el) -> bool { return el->handleEvent(event); }, element);
 
-        // Exit the loop if the
+        // Exit the loop if the event has been handled
         if (hasBeenHandled) break;
     }
-    // If any of them returns true, indicating that the event has been handled on a lower level, handle the own
+    // If none of them returns true, indicating that the event hasn't been handled on a lower level, handle the own
     // container event if applicable
-    if (not hasBeenHandled and callback_) {
-        callback_();
+    if (not hasBeenHandled and hasCallbackType and callbacks_ and (*callbacks_)[static_cast<size_t>(callbackType)]) {
+        (*callbacks_)[static_cast<size_t>(callbackType)](event);
+        hasBeenHandled = true;
     }
 
     // Return this container's handle status
@@ -423,29 +1866,167 @@ bool Container::handleEvent(sf::Event &event) {
 }
 
 // ___________________________________________________________________________
-void Container::computeSize() {
-    // Compute the actual size. Needs parentSize to be set already.
-    size_.x = sizeProportions_.x * parentSize_.x;
-    size_.y = sizeProportions_.y * parentSize_.y;
+void Container::computeSize(unsigned changedInputs) {
+    computeDimensions(changedInputs);
+
+    // In a grid layout, the elements get the size of their cell as parent size in handleGridLayout
+    if (layoutOrientation_ == LayoutOrientation::Grid) {
+        return;
+    }
 
     // Update the parentSize of all child elements
     for (auto& element: elements_) {
         std::visit([this] (auto& el) { el->setParentSize(size_); }, element);
     }
+
+    // Elements depending on their siblings are evaluated once all siblings have their new size
+    updateSiblingExpressions();
+}
+
+// ___________________________________________________________________________
+unsigned Container::computeDimensions(unsigned changedInputs) {
+    // Compute the actual size. Needs parentSize to be set already.
+    sf::Vector2f previousSize = size_;
+    size_.x = computeDimension(sizeDimension, sizeProportions_.x * parentSize_.x, size_.x, changedInputs);
+    size_.y = computeDimension(sizeDimension + 1, sizeProportions_.y * parentSize_.y, size_.y, changedInputs);
+
+    // The own size is an input of the padding and spacing
+    if (size_.x != previousSize.x) {
+        changedInputs |= toInputMask(ExpressionInput::Width);
+    }
+    if (size_.y != previousSize.y) {
+        changedInputs |= toInputMask(ExpressionInput::Height);
+    }
+
+    // Padding and spacing are proportional to the size. Both also mark the grid tracks as outdated
+    computePadding(changedInputs);
+    computeSpacing(changedInputs);
+
+    return changedInputs;
 }
 
 // ___________________________________________________________________________
-void Container::computePadding() {
+void Container::computePadding(unsigned changedInputs) {
     // Compute padding. Needs the size to be set already.
-    padding_.x = paddingProportions_.x * size_.x;
-    padding_.y = paddingProportions_.y * size_.y;
+    padding_.x = computeDimension(paddingDimension, paddingProportions_.x * size_.x, padding_.x, changedInputs);
+    padding_.y = computeDimension(paddingDimension + 1, paddingProportions_.y * size_.y, padding_.y, changedInputs);
+
+    // The grid tracks depend on the padding
+    needGridUpdate_ = true;
 }
 
 // ___________________________________________________________________________
-void Container::computeSpacing() {
+void Container::computeSpacing(unsigned changedInputs) {
     // Compute the spacing. Needs the size to be set already.
-    spacing_.x = spacingProportions_.x * size_.x;
-    spacing_.y = spacingProportions_.y * size_.y;
+    spacing_.x = computeDimension(spacingDimension, spacingProportions_.x * size_.x, spacing_.x, changedInputs);
+    spacing_.y = computeDimension(spacingDimension + 1, spacingProportions_.y * size_.y, spacing_.y, changedInputs);
+
+    // The grid tracks use the spacing as gaps between the rows and columns
+    needGridUpdate_ = true;
+}
+
+// ___________________________________________________________________________
+float Container::computeDimension(size_t dimension, float proportionalValue, float currentValue,
+                                  unsigned changedInputs) const {
+    if (!expressions_ or !(*expressions_)[dimension]) {
+        return proportionalValue;
+    }
+    const auto& expression = (*expressions_)[dimension];
+
+    // Keep the cached value if none of the expression's inputs changed
+    if (changedInputs != allExpressionInputs and (expression->getInputMask() & changedInputs) == 0) {
+        return currentValue;
+    }
+    return expression->evaluate({parentSize_, size_, parent_});
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Re-evaluate all elements depending on their siblings in element order. An element may read a sibling that is
+ * only updated later in the same pass, e.g., A depends on B and B on C in the order A, B, C
+ * - Repeat until no size changes. Each pass settles at least one more link of the longest chain, so a pass per
+ * dependent element suffices. Cycles are rejected when the expressions are set, but may still form by adding
+ * elements, so the passes are limited
+ */
+// ___________________________________________________________________________
+void Container::updateSiblingExpressions() {
+    if (not hasSiblingExpressions_) {
+        return;
+    }
+
+    bool hasChanged = true;
+    for (size_t pass = 0; hasChanged; pass++) {
+        hasChanged = false;
+        size_t dependentCount = 0;
+
+        for (auto& element: elements_) {
+            auto* container = std::get_if<std::unique_ptr<Container>>(&element);
+            if (!container or ((*container)->expressionInputMask_ & toInputMask(ExpressionInput::Sibling)) == 0) {
+                continue;
+            }
+            dependentCount++;
+
+            // The sibling's size changes this element's size, which changes this container's layout
+            sf::Vector2f previousSize = (*container)->getSize();
+            (*container)->computeSize(toInputMask(ExpressionInput::Sibling));
+            if (pass == 0 or (*container)->getSize() != previousSize) {
+                (*container)->requestRenderUpdate();
+                needRenderUpdate_ = true;
+            }
+            if ((*container)->getSize() != previousSize) {
+                hasChanged = true;
+            }
+        }
+
+        if (hasChanged and pass >= dependentCount) {
+            std::cerr << "Sibling size expressions in container '" << name_ << "' don't settle. They probably form a "
+                         "cycle." << std::endl;
+            return;
+        }
+    }
+}
+
+// ___________________________________________________________________________
+bool Container::isSiblingCycle(const Expression &width, const Expression &height) const {
+    if (!parent_) {
+        return false;
+    }
+
+    // Follow the sibling references depth-first. Reaching this container again closes a cycle
+    std::vector<std::string> names = width.getSiblingNames();
+    for (auto& name: height.getSiblingNames()) {
+        names.push_back(name);
+    }
+    std::vector<const Container*> visited;
+    while (!names.empty()) {
+        std::string name = std::move(names.back());
+        names.pop_back();
+
+        const Container* sibling = nullptr;
+        try {
+            sibling = Container::resolve(parent_->findContainer(name));
+        } catch (const std::runtime_error&) {
+            continue;
+        }
+        if (sibling == this) {
+            return true;
+        }
+        if (!sibling or !sibling->expressions_ or
+            std::find(visited.begin(), visited.end(), sibling) != visited.end()) {
+            continue;
+        }
+        visited.push_back(sibling);
+
+        for (size_t dimension = sizeDimension; dimension < sizeDimension + 2; dimension++) {
+            if (const auto& expression = (*sibling->expressions_)[dimension]) {
+                for (auto& siblingName: expression->getSiblingNames()) {
+                    names.push_back(siblingName);
+                }
+            }
+        }
+    }
+    return false;
 }
 
 // ___________________________________________________________________________
@@ -539,6 +2120,10 @@ void Container::handleLayoutOrientation() {
                 currentPosition.y += spacing_.y;
                 break;
 
+            case LayoutOrientation::Grid:
+                // Grid layouts are handled in handleGridLayout
+                break;
+
             case LayoutOrientation::None:
                 // Technically, this only needs to be printed once and also only if the container contains two or
                 // more elements
@@ -824,6 +2409,186 @@ void Container::handleStackedAlignment() {
     }
 }
 
+// ___________________________________________________________________________
+/*
+ * Computes the offsets of the tracks along one grid axis, relative to the container's position. The proportions are
+ * used as weights of the available space, which excludes padding and the gaps between the tracks. Tracks without a
+ * defined proportion get the average weight of the defined ones.
+ */
+// ___________________________________________________________________________
+static std::vector<float> computeTrackOffsets(const std::vector<float>& proportions, int trackCount, float size,
+                                              float padding, float gap) {
+    // Weight for tracks that haven't been defined
+    float defaultWeight = 1;
+    if (!proportions.empty()) {
+        defaultWeight = std::accumulate(proportions.begin(), proportions.end(), 0.f) / proportions.size();
+    }
+
+    std::vector<float> weights(trackCount, defaultWeight);
+    std::copy_n(proportions.begin(), std::min<size_t>(proportions.size(), trackCount), weights.begin());
+    float totalWeight = std::accumulate(weights.begin(), weights.end(), 0.f);
+
+    // Space that is distributed among the tracks
+    float availableSpace = std::max(0.f, size - 2 * padding - gap * static_cast<float>(trackCount - 1));
+
+    // Accumulate the offsets. Each offset includes the gap after the previous track
+    std::vector<float> offsets(trackCount + 1);
+    offsets[0] = padding;
+    for (int track = 0; track < trackCount; track++) {
+        float trackSize = totalWeight > 0 ? availableSpace * weights[track] / totalWeight : 0;
+        offsets[track + 1] = offsets[track] + trackSize + gap;
+    }
+
+    return offsets;
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Place the elements with an explicit cell first, clamping them to the defined columns
+ * - Place the remaining elements into the next free cell in row-major order. The cursor only moves forward, so this
+ * is linear in the number of elements
+ * - Add implicit rows as needed and compute the offsets of both axes
+ */
+// ___________________________________________________________________________
+void Container::computeGridTracks() {
+    GridState& grid = getGridState();
+
+    // Use at least one column, so that elements are placed even if no tracks have been set
+    int columnCount = std::max(1, static_cast<int>(grid.columnProportions.size()));
+    int rowCount = static_cast<int>(grid.rowProportions.size());
+
+    // Occupied cells in row-major order. Grows with the number of rows
+    std::vector<bool> occupiedCells;
+
+    auto occupy = [&](GridPlacement& placement) {
+        rowCount = std::max(rowCount, placement.row + placement.cell.rowSpan);
+        occupiedCells.resize(static_cast<size_t>(rowCount) * columnCount, false);
+
+        for (int row = placement.row; row < placement.row + placement.cell.rowSpan; row++) {
+            for (int column = placement.column; column < placement.column + placement.cell.columnSpan; column++) {
+                occupiedCells[row * columnCount + column] = true;
+            }
+        }
+    };
+
+    auto isFree = [&](int startRow, int startColumn, int rowSpan, int columnSpan) -> bool {
+        for (int row = startRow; row < startRow + rowSpan; row++) {
+            for (int column = startColumn; column < startColumn + columnSpan; column++) {
+                size_t index = row * columnCount + column;
+                if (index < occupiedCells.size() and occupiedCells[index]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    // Clamp the spans to the grid and place the elements with explicit cells
+    for (auto& placement: grid.placements) {
+        placement.cell.rowSpan = std::max(1, placement.cell.rowSpan);
+        placement.cell.columnSpan = std::clamp(placement.cell.columnSpan, 1, columnCount);
+
+        if (placement.cell.row >= 0 and placement.cell.column >= 0) {
+            placement.row = placement.cell.row;
+            placement.column = std::min(placement.cell.column, columnCount - placement.cell.columnSpan);
+            occupy(placement);
+        }
+    }
+
+    // Place the remaining elements automatically
+    size_t cursor = 0;
+    for (auto& placement: grid.placements) {
+        if (placement.cell.row >= 0 and placement.cell.column >= 0) {
+            continue;
+        }
+
+        // Advance the cursor until the element fits into the row without overlapping other elements
+        while (static_cast<int>(cursor % columnCount) + placement.cell.columnSpan > columnCount or
+               !isFree(static_cast<int>(cursor / columnCount), static_cast<int>(cursor % columnCount),
+                       placement.cell.rowSpan, placement.cell.columnSpan)) {
+            cursor++;
+        }
+
+        placement.row = static_cast<int>(cursor / columnCount);
+        placement.column = static_cast<int>(cursor % columnCount);
+        occupy(placement);
+        cursor += placement.cell.columnSpan;
+    }
+
+    // Compute the track offsets. The spacing is used as the gap between the tracks
+    grid.columnOffsets = computeTrackOffsets(grid.columnProportions, columnCount, size_.x, padding_.x, spacing_.x);
+    grid.rowOffsets = computeTrackOffsets(grid.rowProportions, std::max(1, rowCount), size_.y, padding_.y, spacing_.y);
+
+    // Reset the grid update flag
+    needGridUpdate_ = false;
+}
+
+// ___________________________________________________________________________
+// Cells span from the offset of their first tracks to the offset after their last tracks, minus the gap
+// ___________________________________________________________________________
+sf::FloatRect Container::getGridCellBounds(const GridPlacement &placement) const {
+    int endColumn = placement.column + placement.cell.columnSpan;
+    int endRow = placement.row + placement.cell.rowSpan;
+
+    // Read the cell's position and size off the cached offsets. The last offset includes a trailing gap
+    sf::Vector2f cellPosition(grid_->columnOffsets[placement.column], grid_->rowOffsets[placement.row]);
+    sf::Vector2f cellSize(grid_->columnOffsets[endColumn] - cellPosition.x - spacing_.x,
+                          grid_->rowOffsets[endRow] - cellPosition.y - spacing_.y);
+
+    return {cellPosition, cellSize};
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Recompute the tracks only if they are outdated
+ * - Give each element the size of its cell as parent size. Only do this if the cell size changed, since it triggers
+ * a size computation of the element's whole subtree
+ * - Align each element inside its cell according to the alignment case
+ */
+// ___________________________________________________________________________
+void Container::handleGridLayout() {
+    if (needGridUpdate_) {
+        computeGridTracks();
+    }
+
+    // Factor of the free space inside a cell that is used as offset along each axis
+    sf::Vector2f alignmentFactor(0.5, 0.5);
+
+    switch (alignment_) {
+        case Alignment::TopLeading:     alignmentFactor = sf::Vector2f(0, 0);     break;
+        case Alignment::Top:            alignmentFactor = sf::Vector2f(0.5, 0);   break;
+        case Alignment::TopTrailing:    alignmentFactor = sf::Vector2f(1, 0);     break;
+        case Alignment::Leading:        alignmentFactor = sf::Vector2f(0, 0.5);   break;
+        case Alignment::Center:         alignmentFactor = sf::Vector2f(0.5, 0.5); break;
+        case Alignment::Trailing:       alignmentFactor = sf::Vector2f(1, 0.5);   break;
+        case Alignment::BottomLeading:  alignmentFactor = sf::Vector2f(0, 1);     break;
+        case Alignment::Bottom:         alignmentFactor = sf::Vector2f(0.5, 1);   break;
+        case Alignment::BottomTrailing: alignmentFactor = sf::Vector2f(1, 1);     break;
+    }
+
+    for (size_t index = 0; index < elements_.size(); index++) {
+        GridPlacement& placement = grid_->placements[index];
+        sf::FloatRect cellBounds = getGridCellBounds(placement);
+        sf::Vector2f cellPosition(cellBounds.left, cellBounds.top);
+        sf::Vector2f cellSize(cellBounds.width, cellBounds.height);
+
+        // Only propagate the cell size if it changed
+        if (placement.cellSize != cellSize) {
+            std::visit([&cellSize](auto& el) { el->setParentSize(cellSize); }, elements_[index]);
+            placement.cellSize = cellSize;
+        }
+
+        // Align the element inside its cell
+        sf::Vector2f elementSize = std::visit([](auto& el) -> sf::Vector2f { return el->getSize(); }, elements_[index]);
+        sf::Vector2f offset(alignmentFactor.x * (cellSize.x - elementSize.x),
+                            alignmentFactor.y * (cellSize.y - elementSize.y));
+
+        std::visit([&](auto& el) { el->setPosition(position_ + cellPosition + offset); }, elements_[index]);
+    }
+}
+
 // ___________________________________________________________________________
 void Container::computeRenderInformation() {
     // Check the container content here. Raises errors if necessary
@@ -836,12 +2601,18 @@ void Container::computeRenderInformation() {
         backgroundShape_->setSize(size_);
     }
 
-    // Handle the layout and alignment here
-    handleLayoutOrientation();
+    // Handle the layout and alignment here. The grid layout does both in a single pass over the cached tracks
+    if (layoutOrientation_ == LayoutOrientation::Grid) {
+        handleGridLayout();
+    } else {
+        handleLayoutOrientation();
+    }
 
     // This could also be moved to the handleLayout function since there's a switch already present anyway
     switch (layoutOrientation_) {
 
+        case LayoutOrientation::Grid:
+            break;
         case LayoutOrientation::Horizontal:
             handleHorizontalAlignment();
             break;
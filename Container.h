@@ -6,8 +6,39 @@
 #define SWIFTIFYSFML_V0_1_CONTAINER_H
 
 #include <SFML/Graphics.hpp>
+#include <limits>
+#include <optional>
 #include "Enumerations.h"
 #include "UIComponent.h"
+#include "Animation.h"
+#include "SlotMap.h"
+#include "Style.h"
+#include "Expression.h"
+
+/*
+ * GridCell struct. Describes where an element is placed inside a container with a grid layout. A row or column of -1
+ * means that the element is placed automatically into the next free cell in row-major order.
+ */
+struct GridCell {
+    int row = -1;
+    int column = -1;
+    int rowSpan = 1;
+    int columnSpan = 1;
+};
+
+/*
+ * BatchStatistics struct. Counters of the static batches: uploads of vertex data to the graphics card, the uploaded
+ * bytes and the number of batches drawn.
+ */
+struct BatchStatistics {
+    size_t uploads = 0;
+    size_t uploadedBytes = 0;
+    size_t draws = 0;
+};
+
+// Stable handle to a container
+class Container;
+using ContainerHandle = Handle<Container>;
 
 /*
  * Container class. Can store and handle interactions and layout of multiple other Containers or UIComponents.
@@ -16,16 +47,19 @@ class Container {
 public:
     // Constructor and destructor
     Container(std::string name, sf::Vector2f sizeProportions);
-    ~Container() = default;
+    ~Container();
 
     // Delete copy constructor and copy assignment operator
     Container(const Container&) = delete;
     Container& operator=(const Container&) = delete;
 
-    // Move constructor and move assignment operator
+    // Move constructor and move assignment operator. The handle moves along with the container
     Container(Container&& other) noexcept;
     Container& operator=(Container&& other) noexcept;
 
+    // Get the container a handle refers to. Returns nullptr if it doesn't exist anymore
+    static Container* resolve(ContainerHandle handle);
+
     // Setter functions for the non-computed properties
     void setParentSize(sf::Vector2f parentSize);
 
@@ -33,21 +67,61 @@ public:
     void setPaddingProportions(sf::Vector2f paddingProportions);
     void setSpacingProportions(sf::Vector2f spacingProportions);
 
+    // Set expressions for the size, padding or spacing along both axes, e.g., to combine pixel values and
+    // proportions or to match a sibling's size. They replace the respective proportions until these are set again.
+    // Size expressions can't depend on the container's own size. Sibling expressions are evaluated after all other
+    // elements of the parent and may depend on each other in chains, but not in cycles. Throws if the new size
+    // expressions would close a cycle through the siblings.
+    void setSizeExpressions(Expression width, Expression height);
+    void setPaddingExpressions(Expression x, Expression y);
+    void setSpacingExpressions(Expression x, Expression y);
+
     void setPosition(sf::Vector2f position);
     void updatePosition(sf::Vector2f offset);
 
     void setLayoutOrientation(LayoutOrientation layoutOrientation);
     void setAlignment(Alignment alignment);
 
+    // Set the column and row tracks of the grid layout. The proportions are relative weights of the space left after
+    // padding and spacing. Rows that are needed but not defined get the average weight of the defined ones.
+    void setGridTracks(std::vector<float> columnProportions, std::vector<float> rowProportions);
+
+    // Set the grid cell of an element specified by its name
+    void setGridCell(const std::string& name, GridCell cell);
+
+    // Set a callback for a type of event. The callback without an event parameter is registered as click callback
     void setCallback(std::function<void()> callback);
+    void setCallback(CallbackType type, std::function<void(const sf::Event&)> callback);
+
+    // Set the container this container is nested in. Called by the parent when the container is added
+    void setParent(Container* parent);
 
     void setVisible(bool visible);
     void setEnabled(bool enabled);
 
+    // Set the outline, background, padding and spacing of this container only. If the container uses a shared
+    // style, the style is copied first, so that the other containers using it aren't affected
     void setOutline(sf::Color color, float thickness);
     void setBackground(sf::Color color);
 
+    // Round the corners of the background and outline, and draw a shadow beneath the background. Rounded corners and
+    // shadows are drawn by the shape shader, so they can still be batched. Like the background, both can be set on
+    // the style as well
+    void setCornerRadius(float cornerRadius);
+    void setShadow(Shadow shadow);
+
+    // Use a style that can be shared with other containers. While a style is used, the setters above override its
+    // values for this container only, which keeps following the style's other values. Passing nullptr stops using a
+    // style and drops the overrides. The values set so far are kept
+    void setStyle(std::shared_ptr<Style> style);
+    [[nodiscard]] const std::shared_ptr<Style>& getStyle() const;
+
+    // Apply the values of the style. Called by the style when it changes. Only changed padding or spacing cause a
+    // layout update, otherwise only the cached layers are invalidated
+    void applyStyle(bool affectsGeometry);
+
     // Getter functions for the non-internal properties
+    [[nodiscard]] ContainerHandle getHandle() const;
     [[nodiscard]] const std::string& getName() const;
     [[nodiscard]] const sf::Vector2f& getPosition() const;
     [[nodiscard]] const sf::Vector2f& getSize() const;
@@ -57,7 +131,56 @@ public:
     [[nodiscard]] const bool& isVisible() const;
     [[nodiscard]] const bool& isEnabled() const;
 
-    // Get a reference to an element specified by its name
+    // Get the pointer flags. Set by the pointer tracker while the cursor is over the container or it is pressed
+    [[nodiscard]] bool isHovered() const;
+    [[nodiscard]] bool isPressed() const;
+
+    // Render the container and its nested elements once into a texture and draw that texture until something inside
+    // changes. Useful for static parts of a screen. While the layer would exceed the layer memory limit or is empty,
+    // e.g., while the window is minimized, the container is drawn directly.
+    void setCacheAsLayer(bool cacheAsLayer);
+
+    // Draw the backgrounds and outlines of this container's subtree with a single draw call from a vertex buffer on
+    // the graphics card. The geometry is only uploaded again when something in the subtree changes, and batches that
+    // change often are switched to a streaming buffer. Animated, layer-cached and batched containers in the subtree
+    // are drawn separately. The batched backgrounds are drawn beneath all UI components of the subtree, so batches
+    // suit subtrees whose elements don't overlap.
+    void setStaticBatch(bool staticBatch);
+
+    // Mark the cached layers and batches of this container, if includeSelf is set, and of all parent containers as
+    // outdated
+    void invalidateLayers(bool includeSelf = true);
+
+    // Recompute the callback types handled in this container's subtree and pass changes on to the parent containers.
+    // Called by the nested elements when their callbacks change.
+    void updateCallbackMask();
+
+    // Get the callback types handled by this container or any element nested in it
+    [[nodiscard]] unsigned getCallbackMask() const;
+
+    // Get the focus manager of the tree this container is nested in. Returns nullptr if the tree has none
+    [[nodiscard]] FocusManager* getFocusManager() const;
+
+    // Memory limit for all cached layers in bytes and the memory currently used by them
+    static void setLayerMemoryLimit(size_t bytes);
+    [[nodiscard]] static size_t getLayerMemoryLimit();
+    [[nodiscard]] static size_t getLayerMemoryUsage();
+
+    // Get and reset the counters of all batches, e.g., once per frame to get the uploaded bytes per frame
+    [[nodiscard]] static const BatchStatistics& getBatchStatistics();
+    static void resetBatchStatistics();
+
+    // Get the animation state shared with the animator. Created on first access
+    std::shared_ptr<AnimationState> getAnimationState();
+
+    // Add the memory used by this container and its whole subtree to the report
+    void collectMemoryUsage(MemoryReport& report) const;
+
+    // Get the handle of a nested element specified by its name. Throws if no element of that type has that name
+    ContainerHandle findContainer(const std::string& name);
+    UIComponentHandle findUIComponent(const std::string& name);
+
+    // Get a reference to an element specified by its name. Thin wrappers over the handle lookup
     Container& getContainer(const std::string& name);
     UIComponent& getUIComponent(const std::string& name);
 
@@ -65,24 +188,207 @@ public:
     void addContainer(std::unique_ptr<Container> container);
     void addUIComponent(std::unique_ptr<UIComponent> component);
 
+    // Add functions for grid layouts that place the element in a specific cell
+    void addContainer(std::unique_ptr<Container> container, GridCell cell);
+    void addUIComponent(std::unique_ptr<UIComponent> component, GridCell cell);
+
     void removeContainer(const std::string& name);
     void removeUIComponent(const std::string& name);
 
-    // Draw the render information to the screen
-    void draw(sf::RenderWindow& window);
+    // Remove a nested element by its handle. Throws if the element isn't nested in this container
+    void removeContainer(ContainerHandle handle);
+    void removeUIComponent(UIComponentHandle handle);
+
+    // Remove a nested element and return it. The element keeps its handle and cached layout
+    std::unique_ptr<Container> detachContainer(ContainerHandle handle);
+    std::unique_ptr<UIComponent> detachUIComponent(UIComponentHandle handle);
+
+    // Move a nested element to a new index. Indices past the end move it to the end. Finding the element takes
+    // constant time, the move itself is linear in the distance, since only the elements in between are shifted. The
+    // elements stay contiguous, so drawing and layout iterate them without indirection. Only this container is updated
+    void moveElement(ContainerHandle element, size_t index);
+    void moveElement(UIComponentHandle element, size_t index);
+
+    // Reorder all nested elements at once, e.g., after sorting. order[i] is the current index of the element that
+    // ends up at index i. Updates this container only once
+    void reorderElements(const std::vector<size_t>& order);
+
+    // Move a nested element into another container at the given index, or to the end by default. The element keeps
+    // its handle and cached layout, and only the two containers are updated
+    void reparentElement(ContainerHandle element, Container& newParent,
+                         size_t index = std::numeric_limits<size_t>::max());
+    void reparentElement(UIComponentHandle element, Container& newParent,
+                         size_t index = std::numeric_limits<size_t>::max());
+
+    // Reserve space for the given number of nested elements, e.g., before adding many elements at once
+    void reserve(size_t elementCount);
+
+    // Start and commit a batch of changes to this container's subtree. While a batch is open, adding elements
+    // doesn't compute any sizes, callback masks or layers. Committing runs a single measure pass over the whole
+    // subtree, followed by a single arrange pass. Batches can be nested, only the outermost commit runs the passes.
+    void beginBatch();
+    void commitBatch();
+
+    // Compute the pending render information of this container and all nested elements without drawing them
+    void updateLayout();
+
+    // Compute the pending render information of this container and all nested containers, skipping the UI
+    // components. Touches nothing outside of the subtree, so it can run on a worker thread
+    void updateGeometry();
+
+    // Draw the render information to the screen. The render states carry the animated transforms of the parents
+    void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default);
 
     // Handle events by propagating them to the lower nested levels. Returns true, if the event has been handled
-    // at a lower level, else returns false. If no event has been handled, it handles the event with the set
-    // callback, if applicable
+    // at a lower level or by the own callback, else returns false. If no event has been handled, it handles the event
+    // with the set callback of the matching type, if applicable. Elements without a matching callback in their
+    // subtree are skipped, and mouse events are only passed to elements under the cursor.
     bool handleEvent(sf::Event& event);
 
 private:
+    // The focus manager walks the tree to keep its focus chain in layout order. The pointer tracker walks it to find
+    // the elements under the cursor
+    friend class FocusManager;
+    friend class PointerTracker;
+
+    // The animator reads the animation state without creating it and releases it once the animations have ended
+    friend class Animator;
+
+    // Define a new type name to store nested containers and UI components in the same vector
+    using ElementType = std::variant<std::unique_ptr<Container>, std::unique_ptr<UIComponent>>;
+
+    // Grid placement of an element. The resolved row and column and the last assigned cell size are cached to avoid
+    // redundant size updates of the nested elements.
+    struct GridPlacement {
+        GridCell cell;
+        int row = 0;
+        int column = 0;
+        sf::Vector2f cellSize = sf::Vector2f(-1, -1);
+    };
+
+    // Rounded corners and shadow of the background. Only allocated once one of them is set
+    struct Decoration {
+        float cornerRadius = 0;
+        Shadow shadow;
+    };
+
+    // State of the grid layout. Only allocated once the container uses a grid layout or an element is added with a
+    // grid cell. The track offsets are relative to the container's position and have one more entry than tracks, so
+    // that the extent of a span can be read off directly.
+    struct GridState {
+        // Grid placement of each element, stored at the same index as the element in elements_
+        std::vector<GridPlacement> placements;
+
+        // Track weights and the cached track offsets
+        std::vector<float> columnProportions;
+        std::vector<float> rowProportions;
+        std::vector<float> columnOffsets;
+        std::vector<float> rowOffsets;
+    };
+
     // --- Private functions ---
 
-    // Functions to compute the internal dimensions from the parent's dimensions and proportions
-    void computeSize();
-    void computePadding();
-    void computeSpacing();
+    // Registry of all containers, used to resolve handles
+    static SlotMap<Container>& getRegistry();
+
+    // Drop the animation state if nothing but this container uses it and all animated properties are back at their
+    // defaults, so that the container can be part of static batches again
+    void releaseAnimationState();
+
+    // Set the animated background color as the container's own color once no tween animates it anymore, so that
+    // later background and style changes are visible again
+    void takeAnimatedBackground();
+
+    // Get the index of a nested element. Returns the number of elements if it isn't nested here. Constant time, since
+    // every element stores its index
+    [[nodiscard]] size_t findElementIndex(const Container* element) const;
+    [[nodiscard]] size_t findElementIndex(const UIComponent* element) const;
+
+    // Store the indices of the elements in the given range in the elements themselves. Called whenever elements are
+    // inserted, removed or moved, for the range of elements that have been shifted
+    void updateElementIndices(size_t first, size_t last);
+
+    // Insert an element with its grid cell at the given index and take it out again. Both update the dependent state
+    void insertElement(ElementType element, GridCell cell, size_t index);
+    ElementType detachElement(size_t index);
+
+    // Move the element at index 'from' to index 'to'
+    void moveElement(size_t from, size_t to);
+
+    // Returns true if this container or any parent container has an open batch
+    [[nodiscard]] bool isBatching() const;
+
+    // Recompute the sizes, padding, spacing, grid tracks and callback masks of the whole subtree in a single pass.
+    // Unlike computeSize, it doesn't skip elements whose parent size is unchanged. Used when a batch is committed
+    void measureSubtree();
+
+    // Include the callback types of a new element and pass new types on to the parent containers
+    void addToCallbackMask(unsigned callbackMask);
+
+    // Set the render update flag and invalidate the cached layers containing this container
+    void requestRenderUpdate();
+
+    // Get the grid state. Creates it with default placements for the current elements if it doesn't exist yet
+    GridState& getGridState();
+
+    // Get the background shape. Creates it with the current position and size if it doesn't exist yet
+    sf::RectangleShape& getBackgroundShape();
+
+    // Get the decoration. Creates it without rounded corners and shadow if it doesn't exist yet
+    Decoration& getDecoration();
+
+    // Get the values overriding the shared style for this container only. Creates them without any value set
+    Style& getStyleOverrides();
+
+    // Draw the background and the nested elements. The opacity is applied to the background and outline
+    void drawContent(sf::RenderTarget& target, const sf::RenderStates& states, float opacity);
+
+    // Draw the background, outline and shadow with the animated colors and the opacity applied
+    void drawBackground(sf::RenderTarget& target, const sf::RenderStates& states, float opacity);
+
+    // Draw the container from its cached layer. Renders the layer first if it is outdated
+    void drawLayer(sf::RenderTarget& target, const sf::RenderStates& states);
+
+    // Create the layer's render texture. Returns false if the texture would exceed the layer memory limit
+    bool createLayer(sf::Vector2u textureSize);
+
+    // Release the layer's render texture and its memory accounting
+    void releaseLayer();
+
+    // Draw the container from its batch. Rebuilds and uploads the batch first if it is outdated
+    void drawBatch(sf::RenderTarget& target, const sf::RenderStates& states);
+
+    // Forward declaration of the batch, which is defined with the other cached render state
+    struct Batch;
+
+    // Update the layout of the subtree and collect its background geometry and the elements drawn separately
+    void collectBatch(Batch& batch);
+
+    // Append the triangles of the shadow, background and outline to the vertices, encoded for the shape shader if
+    // useShader is set. Applies the animated background color and the opacity
+    void appendBackgroundVertices(std::vector<sf::Vertex>& vertices, bool useShader, float opacity) const;
+
+    // Functions to compute the internal dimensions from the parent's dimensions and the proportions or expressions.
+    // Expressions are only re-evaluated if one of their inputs is in the mask of changed inputs. computeSize passes
+    // the size on to the nested elements, computeDimensions doesn't and returns the changed inputs including the own
+    // size
+    void computeSize(unsigned changedInputs = allExpressionInputs);
+    unsigned computeDimensions(unsigned changedInputs);
+    void computePadding(unsigned changedInputs = allExpressionInputs);
+    void computeSpacing(unsigned changedInputs = allExpressionInputs);
+
+    // Get the value of a dimension along one axis. Evaluates the expression of the dimension if one is set and
+    // affected by the changed inputs, else returns the current value. Without expression, uses the proportional value
+    float computeDimension(size_t dimension, float proportionalValue, float currentValue, unsigned changedInputs) const;
+
+    // Replace the expressions of a dimension along both axes, or remove them by passing nullopt
+    void setExpressions(size_t dimension, std::optional<Expression> x, std::optional<Expression> y);
+
+    // Re-evaluate the nested containers whose expressions depend on their siblings until their sizes settle
+    void updateSiblingExpressions();
+
+    // Returns true if size expressions would make this container's size depend on itself through its siblings
+    [[nodiscard]] bool isSiblingCycle(const Expression& width, const Expression& height) const;
 
     // Checks the container content. Provides user feedback in the case of errors or inconsistencies.
     void validateContainerContent();
@@ -100,6 +406,15 @@ private:
     void handleVerticalAlignment();
     void handleStackedAlignment();
 
+    // Resolve the grid cells of all elements and compute the track sizes. Only called if the cached tracks are outdated
+    void computeGridTracks();
+
+    // Get the bounds of an element's grid cell relative to the container's position. Needs up-to-date tracks
+    [[nodiscard]] sf::FloatRect getGridCellBounds(const GridPlacement& placement) const;
+
+    // Set the parent size and position of all elements in the grid layout in a single pass
+    void handleGridLayout();
+
     // --- Private variables ---
 
     // Flag indicating if the render information needs to be updated. Only set internally.
@@ -109,6 +424,9 @@ private:
     // gotten afterward.
     std::string name_;
 
+    // Stable handle to this container. Registered in the constructor and removed in the destructor
+    ContainerHandle handle_;
+
     // Absolute size of the parent container. Calculated internally
     sf::Vector2f parentSize_;
 
@@ -126,24 +444,102 @@ private:
     sf::Vector2f padding_;
     sf::Vector2f spacing_;
 
+    // Optional expressions replacing the proportions, stored per dimension and axis: size, padding and spacing, each
+    // with x and y. Only allocated once an expression is set, since most containers only use proportions. The mask is
+    // the union of their inputs
+    static constexpr size_t sizeDimension = 0;
+    static constexpr size_t paddingDimension = 2;
+    static constexpr size_t spacingDimension = 4;
+    std::unique_ptr<std::array<std::optional<Expression>, 6>> expressions_ = nullptr;
+    unsigned expressionInputMask_ = 0;
+
+    // Flag indicating if any nested container might depend on its siblings. Avoids scanning the elements otherwise
+    bool hasSiblingExpressions_ = false;
+
     // Variables that affect the positioning of the nested elements. Can only be set.
     LayoutOrientation layoutOrientation_;
     Alignment alignment_;
 
-    // Define a new type name and a variable to store nested containers and UI components in the same vector. This is
-    // important because the order of adding components affects the layout.
-    using ElementType = std::variant<std::unique_ptr<Container>, std::unique_ptr<UIComponent>>;
+    // Variable to store nested containers and UI components in the same vector. This is important because the order
+    // of adding components affects the layout.
     std::vector<ElementType> elements_;
 
-    // Stores the callback function that should be executed when an event is recognized.
-    std::function<void()> callback_;
+    // Optional grid state. If it exists, it has a placement for every element
+    std::unique_ptr<GridState> grid_ = nullptr;
+
+    // Flag indicating if the cached grid tracks need to be recomputed. Set if tracks, elements or dimensions change.
+    bool needGridUpdate_;
+
+    // Number of open batches on this container
+    unsigned batchDepth_ = 0;
+
+    // Stores the callback functions that should be executed when an event is recognized. Only allocated once a
+    // callback is set, since most containers don't have any
+    std::unique_ptr<CallbackTable> callbacks_ = nullptr;
+
+    // Callback types set on this container and callback types handled anywhere in its subtree, including itself
+    unsigned callbackMask_ = 0;
+    unsigned subtreeCallbackMask_ = 0;
 
     // Booleans to handle visibility and responsiveness. Only used internally
     bool isEnabled_;
     bool isVisible_;
 
+    // Flags indicating if the cursor is over the container and if it is pressed. Only set by the pointer tracker
+    bool isHovered_ = false;
+    bool isPressed_ = false;
+
     // Optional sf::RectangleShape instance. Can display a background
     std::unique_ptr<sf::RectangleShape> backgroundShape_ = nullptr;
+
+    // Optional rounded corners and shadow of the background
+    std::unique_ptr<Decoration> decoration_ = nullptr;
+
+    // Optional shared style and the values overridden for this container only. The overrides take precedence over the
+    // shared style and are only used together with it
+    std::shared_ptr<Style> style_ = nullptr;
+    std::unique_ptr<Style> styleOverrides_ = nullptr;
+
+    // Optional animation state. Only created if the container is animated
+    std::shared_ptr<AnimationState> animationState_ = nullptr;
+
+    // Container this container is nested in and the index in its elements. Not owned
+    Container* parent_ = nullptr;
+    size_t indexInParent_ = 0;
+
+    // Focus manager of the tree. Only set on root containers that have one. Not owned
+    FocusManager* focusManager_ = nullptr;
+
+    // Cached layer. Holds the rendered container and a flag indicating if it is still up to date
+    struct Layer {
+        sf::RenderTexture texture;
+        size_t memoryUsage = 0;
+        bool isValid = false;
+    };
+    bool cacheAsLayer_ = false;
+    std::unique_ptr<Layer> layer_ = nullptr;
+
+    // Texture size the layer couldn't be created for. The layer is only created again once the size changes
+    std::optional<sf::Vector2u> failedLayerSize_;
+
+    // Static batch. Holds the background geometry of the subtree, the shader it is drawn with, the elements drawn on
+    // top of it in drawing order, and the number of draws since the last upload to detect frequently changing batches
+    struct Batch {
+        sf::VertexBuffer buffer = sf::VertexBuffer(sf::Triangles, sf::VertexBuffer::Static);
+        std::vector<sf::Vertex> vertices;
+        const sf::Shader* shader = nullptr;
+        std::vector<std::variant<Container*, UIComponent*>> separateElements;
+        size_t drawsSinceUpload = 0;
+        bool isValid = false;
+    };
+    std::unique_ptr<Batch> batch_ = nullptr;
+
+    // Memory used by all cached layers and its limit in bytes
+    static size_t layerMemoryUsage_;
+    static size_t layerMemoryLimit_;
+
+    // Counters of all batches
+    static BatchStatistics batchStatistics_;
 };
 
 #endif //SWIFTIFYSFML_V0_1_CONTAINER_H
@@ -0,0 +1,483 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "DataGrid.h"
+#include "ShapeGeometry.h"
+#include "TextGeometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+// ___________________________________________________________________________
+DataGrid::DataGrid(std::string name, const sf::Vector2f &sizeProportions, std::shared_ptr<sf::Font> font,
+                   unsigned characterSize)
+: UIComponent(std::move(name), sizeProportions), font_(std::move(font)), characterSize_(characterSize) {
+    // Clicks on the headers and rows arrive through the tree
+    addHandledCallbackTypes(toCallbackMask(CallbackType::Click));
+}
+
+// ___________________________________________________________________________
+size_t DataGrid::addColumn(std::string title, float width, bool isNumeric) {
+    Column column;
+    column.title = std::move(title);
+    column.width = width;
+    column.isNumeric = isNumeric;
+    for (size_t row = 0; row < rowCount_; row++) {
+        appendCell(column, {});
+    }
+    columns_.push_back(std::move(column));
+
+    requestRenderUpdate();
+    return columns_.size() - 1;
+}
+
+// ___________________________________________________________________________
+size_t DataGrid::appendRow(const std::vector<std::string> &cells) {
+    if (rowCount_ >= std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("Data grid '" + name_ + "' can't hold more rows.");
+    }
+
+    for (size_t column = 0; column < columns_.size(); column++) {
+        appendCell(columns_[column], column < cells.size() ? std::string_view(cells[column]) : std::string_view());
+    }
+    rowCount_++;
+
+    // The row is merged into the display order with the next render update, together with the other appended rows
+    if (!needRenderUpdate_) {
+        requestRenderUpdate();
+    }
+    return rowCount_ - 1;
+}
+
+// ___________________________________________________________________________
+void DataGrid::sortByColumn(size_t column, bool ascending) {
+    if (column >= columns_.size()) {
+        throw std::runtime_error("Column index " + std::to_string(column) + " is out of range.");
+    }
+
+    sortColumn_ = column;
+    isAscending_ = ascending;
+    rebuildOrder();
+}
+
+// ___________________________________________________________________________
+void DataGrid::clearSort() {
+    sortColumn_ = noRow;
+    rebuildOrder();
+}
+
+// ___________________________________________________________________________
+void DataGrid::setFilter(std::function<bool(const DataGrid &, size_t)> filter) {
+    filter_ = std::move(filter);
+    rebuildOrder();
+}
+
+// ___________________________________________________________________________
+void DataGrid::clearFilter() {
+    filter_ = nullptr;
+    rebuildOrder();
+}
+
+// ___________________________________________________________________________
+void DataGrid::selectRow(size_t row) {
+    selectedRow_ = row < rowCount_ ? row : noRow;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void DataGrid::setTextColor(sf::Color color) {
+    textColor_ = color;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void DataGrid::setHeaderColor(sf::Color color) {
+    headerColor_ = color;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void DataGrid::setStripeColor(sf::Color color) {
+    stripeColor_ = color;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void DataGrid::setSelectionColor(sf::Color color) {
+    selectionColor_ = color;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void DataGrid::setScrollOffset(sf::Vector2f scrollOffset) {
+    sf::Vector2f maxScrollOffset = getMaxScrollOffset();
+    scrollOffset.x = std::clamp(scrollOffset.x, 0.f, maxScrollOffset.x);
+    scrollOffset.y = std::clamp(scrollOffset.y, 0.f, maxScrollOffset.y);
+    if (scrollOffset != scrollOffset_) {
+        scrollOffset_ = scrollOffset;
+        requestRenderUpdate();
+    }
+}
+
+// ___________________________________________________________________________
+std::string_view DataGrid::getCell(size_t row, size_t column) const {
+    if (row >= rowCount_ or column >= columns_.size()) {
+        throw std::runtime_error("Cell (" + std::to_string(row) + ", " + std::to_string(column) + ") is out of range.");
+    }
+    return getCellText(columns_[column], row);
+}
+
+// ___________________________________________________________________________
+size_t DataGrid::getColumnCount() const {
+    return columns_.size();
+}
+
+// ___________________________________________________________________________
+size_t DataGrid::getRowCount() const {
+    return rowCount_;
+}
+
+// ___________________________________________________________________________
+size_t DataGrid::getDisplayedRowCount() const {
+    return order_.size();
+}
+
+// ___________________________________________________________________________
+size_t DataGrid::getDisplayedRow(size_t position) const {
+    return position < order_.size() ? order_[position] : noRow;
+}
+
+// ___________________________________________________________________________
+size_t DataGrid::getSelectedRow() const {
+    return selectedRow_;
+}
+
+// ___________________________________________________________________________
+sf::Vector2f DataGrid::getScrollOffset() const {
+    return scrollOffset_;
+}
+
+// ___________________________________________________________________________
+size_t DataGrid::getSortColumn() const {
+    return sortColumn_;
+}
+
+// ___________________________________________________________________________
+void DataGrid::draw(sf::RenderTarget &target, sf::RenderStates states) {
+    if (!isVisible_) {
+        return;
+    }
+
+    if (!backgroundVertices_.empty()) {
+        target.draw(backgroundVertices_.data(), backgroundVertices_.size(), sf::Triangles, states);
+    }
+    if (!glyphVertices_.empty()) {
+        states.texture = &font_->getTexture(characterSize_);
+        target.draw(glyphVertices_.data(), glyphVertices_.size(), sf::Triangles, states);
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Clicking a header sorts by its column, or reverses the direction if the table is sorted by it already
+ * - Clicking a row selects it and calls the click callback, which can read the selected row
+ * - The mouse wheel scrolls by three rows. Mouse wheel events reach all elements, so the cursor position is checked
+ * here
+ */
+// ___________________________________________________________________________
+bool DataGrid::handleEvent(const sf::Event &event) {
+    sf::FloatRect bounds(position_, size_);
+    float rowHeight = getRowHeight();
+
+    if (event.type == sf::Event::MouseButtonPressed) {
+        sf::Vector2f mousePosition(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y));
+        if (event.mouseButton.button != sf::Mouse::Left or !bounds.contains(mousePosition)) {
+            return false;
+        }
+
+        sf::Vector2f localPosition = mousePosition - position_;
+        if (localPosition.y < rowHeight) {
+            float columnRight = -scrollOffset_.x;
+            for (size_t column = 0; column < columns_.size(); column++) {
+                columnRight += columns_[column].width;
+                if (localPosition.x < columnRight) {
+                    sortByColumn(column, sortColumn_ == column ? not isAscending_ : true);
+                    break;
+                }
+            }
+            return true;
+        }
+
+        auto position = static_cast<size_t>((localPosition.y - rowHeight + scrollOffset_.y) / rowHeight);
+        if (position < order_.size()) {
+            selectRow(order_[position]);
+            invokeCallback(CallbackType::Click, event);
+        }
+        return true;
+    }
+
+    if (event.type == sf::Event::MouseWheelScrolled) {
+        sf::Vector2f mousePosition(static_cast<float>(event.mouseWheelScroll.x),
+                                   static_cast<float>(event.mouseWheelScroll.y));
+        if (!bounds.contains(mousePosition)) {
+            return false;
+        }
+
+        float distance = std::round(event.mouseWheelScroll.delta * 3) * rowHeight;
+        if (event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel) {
+            setScrollOffset(scrollOffset_ - sf::Vector2f(0, distance));
+        } else {
+            setScrollOffset(scrollOffset_ - sf::Vector2f(distance, 0));
+        }
+        return true;
+    }
+
+    return false;
+}
+
+// ___________________________________________________________________________
+void DataGrid::updateRenderInformation() {
+    size_ = sf::Vector2f(parentSize_.x * sizeProportions_.x, parentSize_.y * sizeProportions_.y);
+    mergeAppendedRows();
+
+    // The table or the view may have shrunk
+    sf::Vector2f maxScrollOffset = getMaxScrollOffset();
+    scrollOffset_.x = std::clamp(scrollOffset_.x, 0.f, maxScrollOffset.x);
+    scrollOffset_.y = std::clamp(scrollOffset_.y, 0.f, maxScrollOffset.y);
+
+    buildVertices();
+    needRenderUpdate_ = false;
+}
+
+// ___________________________________________________________________________
+void DataGrid::collectMemoryUsage(MemoryReport &report) const {
+    UIComponent::collectMemoryUsage(report);
+    report.uiComponentBytes += sizeof(DataGrid) - sizeof(UIComponent);
+    report.layoutBytes += columns_.capacity() * sizeof(Column) + order_.capacity() * sizeof(std::uint32_t);
+    for (auto& column: columns_) {
+        report.assetBytes += getHeapBytes(column.title) + column.text.capacity() +
+                             column.cellEnds.capacity() * sizeof(std::uint64_t) +
+                             column.values.capacity() * sizeof(double);
+    }
+    report.renderBytes += (backgroundVertices_.capacity() + glyphVertices_.capacity()) * sizeof(sf::Vertex);
+}
+
+// ___________________________________________________________________________
+void DataGrid::appendCell(Column &column, std::string_view text) {
+    column.text.append(text);
+    column.cellEnds.push_back(column.text.size());
+
+    if (column.isNumeric) {
+        // The buffer isn't null-terminated between cells, so the cell is parsed from a copy
+        std::string cell(text);
+        char* end = nullptr;
+        double value = std::strtod(cell.c_str(), &end);
+        column.values.push_back(end == cell.c_str() ? std::nan("") : value);
+    }
+}
+
+// ___________________________________________________________________________
+std::string_view DataGrid::getCellText(const Column &column, size_t row) {
+    std::uint64_t begin = row > 0 ? column.cellEnds[row - 1] : 0;
+    return std::string_view(column.text).substr(begin, column.cellEnds[row] - begin);
+}
+
+// ___________________________________________________________________________
+bool DataGrid::isSortedBefore(std::uint32_t first, std::uint32_t second) const {
+    const Column& column = columns_[sortColumn_];
+    if (!isAscending_) {
+        std::swap(first, second);
+    }
+
+    // Cells that aren't numbers go after all numbers in ascending order
+    if (column.isNumeric) {
+        double firstValue = column.values[first];
+        double secondValue = column.values[second];
+        return !std::isnan(firstValue) and (std::isnan(secondValue) or firstValue < secondValue);
+    }
+    return getCellText(column, first) < getCellText(column, second);
+}
+
+// ___________________________________________________________________________
+void DataGrid::rebuildOrder() {
+    order_.clear();
+    for (size_t row = 0; row < rowCount_; row++) {
+        if (!filter_ or filter_(*this, row)) {
+            order_.push_back(static_cast<std::uint32_t>(row));
+        }
+    }
+    mergedRowCount_ = rowCount_;
+
+    if (sortColumn_ != noRow) {
+        std::stable_sort(order_.begin(), order_.end(),
+                         [this](std::uint32_t first, std::uint32_t second) { return isSortedBefore(first, second); });
+    }
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Filter the appended rows. Without a sort, they are displayed after the other rows in the order they were appended
+ * - Otherwise, sort them and find the position of each in the display order with a binary search. Each search
+ * starts at the previous position, since the appended rows are sorted. Equal rows go after the existing ones, so the
+ * sort stays stable
+ * - Move the displayed rows back in a single pass from the end, inserting the appended rows on the way. This moves
+ * each displayed row once and compares only logarithmically many rows per appended one
+ */
+// ___________________________________________________________________________
+void DataGrid::mergeAppendedRows() {
+    if (mergedRowCount_ == rowCount_) {
+        return;
+    }
+
+    std::vector<std::uint32_t> appendedRows;
+    for (size_t row = mergedRowCount_; row < rowCount_; row++) {
+        if (!filter_ or filter_(*this, row)) {
+            appendedRows.push_back(static_cast<std::uint32_t>(row));
+        }
+    }
+    mergedRowCount_ = rowCount_;
+
+    if (sortColumn_ == noRow) {
+        order_.insert(order_.end(), appendedRows.begin(), appendedRows.end());
+        return;
+    }
+
+    auto isBefore = [this](std::uint32_t first, std::uint32_t second) { return isSortedBefore(first, second); };
+    std::stable_sort(appendedRows.begin(), appendedRows.end(), isBefore);
+
+    std::vector<size_t> positions(appendedRows.size());
+    auto searchStart = order_.begin();
+    for (size_t index = 0; index < appendedRows.size(); index++) {
+        searchStart = std::upper_bound(searchStart, order_.end(), appendedRows[index], isBefore);
+        positions[index] = static_cast<size_t>(searchStart - order_.begin());
+    }
+
+    size_t read = order_.size();
+    order_.resize(order_.size() + appendedRows.size());
+    size_t write = order_.size();
+    for (size_t index = appendedRows.size(); index-- > 0;) {
+        while (read > positions[index]) {
+            order_[--write] = order_[--read];
+        }
+        order_[--write] = appendedRows[index];
+    }
+}
+
+// ___________________________________________________________________________
+float DataGrid::getRowHeight() const {
+    return std::max(font_->getLineSpacing(characterSize_), 1.f) + 2 * cellPadding_;
+}
+
+// ___________________________________________________________________________
+float DataGrid::getTableWidth() const {
+    float width = 0;
+    for (auto& column: columns_) {
+        width += column.width;
+    }
+    return width;
+}
+
+// ___________________________________________________________________________
+sf::Vector2f DataGrid::getMaxScrollOffset() const {
+    float rowHeight = getRowHeight();
+    return {std::max(0.f, getTableWidth() - size_.x),
+            std::max(0.f, static_cast<float>(order_.size()) * rowHeight - (size_.y - rowHeight))};
+}
+
+// ___________________________________________________________________________
+void DataGrid::appendCellText(std::string_view text, sf::Vector2f position, float left, float right) {
+    for (size_t index = 0; index < text.size();) {
+        std::uint32_t character;
+        index = decodeUtf8(text, index, character);
+        const sf::Glyph& glyph = font_->getGlyph(character, characterSize_, false);
+        if (position.x + glyph.advance > right) {
+            return;
+        }
+        if (position.x >= left and character != ' ') {
+            appendGlyph(glyphVertices_, glyph, position, textColor_);
+        }
+        position.x += glyph.advance;
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Find the columns overlapping the view horizontally and the rows completely inside it vertically. Only these are
+ * visited, so the cost depends on the size of the view and not on the size of the table
+ * - The header row stays at the top while scrolling vertically. The sort column's title is marked with its direction
+ * - Rows get the selection color if they are selected and a stripe on every other row. Cell text is cut off at the
+ * end of its cell and at the edges of the view
+ */
+// ___________________________________________________________________________
+void DataGrid::buildVertices() {
+    backgroundVertices_.clear();
+    glyphVertices_.clear();
+
+    float rowHeight = getRowHeight();
+    float left = position_.x;
+    float right = position_.x + size_.x;
+    float tableRight = std::min(right, position_.x + getTableWidth() - scrollOffset_.x);
+    if (tableRight <= left) {
+        return;
+    }
+
+    // Left edges of the visible columns
+    std::vector<std::pair<size_t, float>> visibleColumns;
+    float columnLeft = position_.x - scrollOffset_.x;
+    for (size_t column = 0; column < columns_.size() and columnLeft < right; column++) {
+        if (columnLeft + columns_[column].width > left) {
+            visibleColumns.emplace_back(column, columnLeft);
+        }
+        columnLeft += columns_[column].width;
+    }
+
+    auto firstPosition = static_cast<size_t>(std::ceil(scrollOffset_.y / rowHeight));
+    // The row at a position is below the header, so it is completely inside the view if its position is at most the
+    // number of rows fitting into the view minus two
+    float fittingRows = std::floor((scrollOffset_.y + size_.y) / rowHeight);
+    size_t endPosition = fittingRows >= 1 ? std::min(order_.size(), static_cast<size_t>(fittingRows) - 1) : 0;
+    float textOffset = cellPadding_ + static_cast<float>(characterSize_);
+
+    // Header
+    appendRectangle(backgroundVertices_, {left, position_.y, tableRight - left, rowHeight}, headerColor_);
+    for (auto& [column, x]: visibleColumns) {
+        std::string title = columns_[column].title;
+        if (column == sortColumn_) {
+            title += isAscending_ ? " ^" : " v";
+        }
+        appendCellText(title, {x + cellPadding_, position_.y + textOffset}, left,
+                       std::min(x + columns_[column].width - cellPadding_, right));
+    }
+
+    // Rows
+    for (size_t position = firstPosition; position < endPosition; position++) {
+        size_t row = order_[position];
+        float top = position_.y + rowHeight * static_cast<float>(position + 1) - scrollOffset_.y;
+        if (row == selectedRow_) {
+            appendRectangle(backgroundVertices_, {left, top, tableRight - left, rowHeight}, selectionColor_);
+        } else if (position % 2 == 1) {
+            appendRectangle(backgroundVertices_, {left, top, tableRight - left, rowHeight}, stripeColor_);
+        }
+
+        for (auto& [column, x]: visibleColumns) {
+            appendCellText(getCellText(columns_[column], row), {x + cellPadding_, top + textOffset}, left,
+                           std::min(x + columns_[column].width - cellPadding_, right));
+        }
+    }
+
+    // Separators at the right edges of the visible columns
+    float separatorHeight = rowHeight * static_cast<float>(endPosition - std::min(firstPosition, endPosition) + 1);
+    for (auto& [column, x]: visibleColumns) {
+        float separatorX = x + columns_[column].width - 1;
+        if (separatorX >= left and separatorX < right) {
+            appendRectangle(backgroundVertices_, {separatorX, position_.y, 1, separatorHeight}, headerColor_);
+        }
+    }
+}
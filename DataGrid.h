@@ -0,0 +1,160 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_DATAGRID_H
+#define SWIFTIFYSFML_V0_1_DATAGRID_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "UIComponent.h"
+
+/*
+ * DataGrid class. Table of text cells with a header row, drawn as a single UI component instead of a container per
+ * cell. The cells are stored per column in one text buffer, and rows are only appended. What is shown is a separate
+ * display order: the indices of the rows passing the filter, in sort order. Sorting permutes the indices, and
+ * appended rows are merged into them, so the data itself is never rebuilt. Only the rows and columns inside the view
+ * are turned into vertices: all cell text goes into one glyph batch and all backgrounds into another, so drawing
+ * takes two draw calls regardless of the size of the table. Clicking a header sorts by its column, clicking a row
+ * selects it.
+ */
+class DataGrid : public UIComponent {
+public:
+    // Index meaning no row
+    static constexpr size_t noRow = std::numeric_limits<size_t>::max();
+
+    // Constructor and destructor. The font is shared with the asset cache
+    DataGrid(std::string name, const sf::Vector2f& sizeProportions, std::shared_ptr<sf::Font> font,
+             unsigned characterSize = 14);
+    ~DataGrid() override = default;
+
+    // Add a column of a width in pixels. Numeric columns sort by the value of their cells, others by their text.
+    // Existing rows get empty cells. Returns the index of the column
+    size_t addColumn(std::string title, float width, bool isNumeric = false);
+
+    // Append a row. Missing cells are empty, extra cells are ignored. The row is merged into the display order with the
+    // next render update. Returns the index of the row
+    size_t appendRow(const std::vector<std::string>& cells);
+
+    // Sort the displayed rows by a column. Rows with equal cells keep their order. Clearing the sort shows the rows in
+    // the order they were appended
+    void sortByColumn(size_t column, bool ascending = true);
+    void clearSort();
+
+    // Only show the rows a filter returns true for. The filter gets the row index and can read the cells with getCell
+    void setFilter(std::function<bool(const DataGrid&, size_t)> filter);
+    void clearFilter();
+
+    // Select a row, or no row with noRow
+    void selectRow(size_t row);
+
+    // Appearance
+    void setTextColor(sf::Color color);
+    void setHeaderColor(sf::Color color);
+    void setStripeColor(sf::Color color);
+    void setSelectionColor(sf::Color color);
+
+    // Scroll to an offset in pixels. Clamped to the size of the table
+    void setScrollOffset(sf::Vector2f scrollOffset);
+
+    // Get the text of a cell. Valid until the next row is appended
+    [[nodiscard]] std::string_view getCell(size_t row, size_t column) const;
+
+    // Get the number of columns, all rows and the displayed rows. The displayed rows include appended rows only after
+    // the next render update
+    [[nodiscard]] size_t getColumnCount() const;
+    [[nodiscard]] size_t getRowCount() const;
+    [[nodiscard]] size_t getDisplayedRowCount() const;
+
+    // Get the row shown at a position of the display order
+    [[nodiscard]] size_t getDisplayedRow(size_t position) const;
+
+    // Get the selected row, the scroll offset and the sort column, which is noRow if unsorted
+    [[nodiscard]] size_t getSelectedRow() const;
+    [[nodiscard]] sf::Vector2f getScrollOffset() const;
+    [[nodiscard]] size_t getSortColumn() const;
+
+    // UI-related functions
+    void draw(sf::RenderTarget& target, sf::RenderStates states) override;
+    bool handleEvent(const sf::Event& event) override;
+    void updateRenderInformation() override;
+    void collectMemoryUsage(MemoryReport& report) const override;
+
+private:
+    // Column with the text of its cells in one buffer. Cells refer to their range of the buffer. Numeric columns also
+    // keep the values of their cells, which are NaN for cells that aren't numbers
+    struct Column {
+        std::string title;
+        float width = 0;
+        bool isNumeric = false;
+        std::string text;
+        std::vector<std::uint64_t> cellEnds;
+        std::vector<double> values;
+    };
+
+    // Append a cell to a column, and get the text of a cell
+    static void appendCell(Column& column, std::string_view text);
+    static std::string_view getCellText(const Column& column, size_t row);
+
+    // Returns true if the first row is displayed before the second one in the sort order
+    [[nodiscard]] bool isSortedBefore(std::uint32_t first, std::uint32_t second) const;
+
+    // Build the display order of all rows again, e.g., after the sort or the filter changed
+    void rebuildOrder();
+
+    // Merge the rows appended since the last update into the display order
+    void mergeAppendedRows();
+
+    // Get the height of a row, including the header row, and the width of all columns
+    [[nodiscard]] float getRowHeight() const;
+    [[nodiscard]] float getTableWidth() const;
+
+    // Get the largest scroll offset
+    [[nodiscard]] sf::Vector2f getMaxScrollOffset() const;
+
+    // Append the glyphs of a cell's text, clipped to the left and right bounds
+    void appendCellText(std::string_view text, sf::Vector2f position, float left, float right);
+
+    // Rebuild the vertices of the visible header cells, rows and backgrounds
+    void buildVertices();
+
+    // Font and character size of the cells
+    std::shared_ptr<sf::Font> font_;
+    unsigned characterSize_;
+
+    // Columns with their cells and the number of rows
+    std::vector<Column> columns_;
+    size_t rowCount_ = 0;
+
+    // Displayed rows in display order, and the number of rows already merged into it
+    std::vector<std::uint32_t> order_;
+    size_t mergedRowCount_ = 0;
+
+    // Sort column and direction, and the filter
+    size_t sortColumn_ = noRow;
+    bool isAscending_ = true;
+    std::function<bool(const DataGrid&, size_t)> filter_;
+
+    // Selected row and the scroll offset in pixels
+    size_t selectedRow_ = noRow;
+    sf::Vector2f scrollOffset_;
+
+    // Appearance
+    sf::Color textColor_ = sf::Color::White;
+    sf::Color headerColor_ = sf::Color(60, 60, 60);
+    sf::Color stripeColor_ = sf::Color(255, 255, 255, 16);
+    sf::Color selectionColor_ = sf::Color(70, 110, 200);
+    float cellPadding_ = 4;
+
+    // Vertices of the backgrounds and the glyphs of the visible cells, rebuilt with the render information
+    std::vector<sf::Vertex> backgroundVertices_;
+    std::vector<sf::Vertex> glyphVertices_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_DATAGRID_H
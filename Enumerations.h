@@ -28,12 +28,13 @@ enum class Alignment {
 
 /*
  * LayoutOrientation enum class. Alignment cases for the elements inside a container. Supports horizontal, vertical,
- * and stacked.
+ * stacked, and grid. The grid places its elements in cells defined by row and column tracks.
  */
 enum class LayoutOrientation {
     Horizontal,
     Vertical,
     Stacked,
+    Grid,
 
     // Should there be a default?
     None
@@ -53,4 +54,82 @@ enum class PaddingOrientation {
     All
 };
 
+
+/*
+ * CallbackType enum class. Kinds of events a callback can be registered for. Click callbacks react to mouse button
+ * presses, hover callbacks to mouse movement, and key callbacks to key presses, key releases and text input. Enter,
+ * leave, press and release callbacks are called by the pointer tracker when the element's hovered or pressed state
+ * changes.
+ */
+enum class CallbackType {
+    Click,
+    Hover,
+    Key,
+    Enter,
+    Leave,
+    Press,
+    Release
+};
+
+// Number of callback types and the bit of a callback type in a callback mask
+constexpr unsigned callbackTypeCount = 7;
+constexpr unsigned toCallbackMask(CallbackType type) {
+    return 1u << static_cast<unsigned>(type);
+}
+
+// Bit marking focusable UI components in a callback mask. Lets the focus manager skip subtrees without any focusable
+// component
+constexpr unsigned focusableMask = 1u << callbackTypeCount;
+
+/*
+ * TransitionType enum class. Visual transitions between two screens. 'None' switches as soon as the next screen is
+ * prepared. The slide cases name the direction in which the screens move.
+ */
+enum class TransitionType {
+    None,
+    CrossFade,
+    SlideLeft,
+    SlideRight,
+    SlideUp,
+    SlideDown
+};
+
+/*
+ * Easing enum class. Easing curves that can be used by animations to map the elapsed time to the progress.
+ */
+enum class Easing {
+    Linear,
+    EaseIn,
+    EaseOut,
+    EaseInOut
+};
+
+/*
+ * Decimation enum class. Ways a plot reduces the samples of a series to one or two points per pixel column. MinMax
+ * keeps the lowest and the highest sample of each column, so that spikes stay visible. LargestTriangle keeps one
+ * sample per column, chosen by the largest-triangle-three-buckets algorithm, which keeps the shape with fewer points.
+ */
+enum class Decimation {
+    MinMax,
+    LargestTriangle
+};
+
+/*
+ * ExpressionInput enum class. Values an expression can depend on. Width and height refer to the container's own size
+ * and can only be used for padding and spacing. Sibling covers the sizes of all referenced sibling containers.
+ */
+enum class ExpressionInput {
+    ParentWidth,
+    ParentHeight,
+    Width,
+    Height,
+    Sibling
+};
+
+// Bit of an input in an input mask, and the mask forcing all expressions to be evaluated
+constexpr unsigned toInputMask(ExpressionInput input) {
+    return 1u << static_cast<unsigned>(input);
+}
+constexpr unsigned allExpressionInputs = ~0u;
+
 #endif //SWIFTIFYSFML_V0_1_ENUMERATIONS_H
@@ -0,0 +1,226 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "Expression.h"
+#include "Container.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <stdexcept>
+
+// ___________________________________________________________________________
+Expression::Expression(float pixels) : program_{{OpCode::Constant, pixels}} {}
+
+// ___________________________________________________________________________
+Expression Expression::parentWidth(float factor) {
+    return input(ExpressionInput::ParentWidth, factor);
+}
+
+// ___________________________________________________________________________
+Expression Expression::parentHeight(float factor) {
+    return input(ExpressionInput::ParentHeight, factor);
+}
+
+// ___________________________________________________________________________
+Expression Expression::width(float factor) {
+    return input(ExpressionInput::Width, factor);
+}
+
+// ___________________________________________________________________________
+Expression Expression::height(float factor) {
+    return input(ExpressionInput::Height, factor);
+}
+
+// ___________________________________________________________________________
+Expression Expression::siblingWidth(const std::string &name, float factor) {
+    Expression expression(0);
+    expression.program_[0] = {OpCode::Sibling, factor, 0};
+    expression.siblings_.push_back({name, true, {}});
+    expression.inputMask_ = toInputMask(ExpressionInput::Sibling);
+    return expression;
+}
+
+// ___________________________________________________________________________
+Expression Expression::siblingHeight(const std::string &name, float factor) {
+    Expression expression = siblingWidth(name, factor);
+    expression.siblings_[0].isWidth = false;
+    return expression;
+}
+
+// ___________________________________________________________________________
+Expression operator+(Expression lhs, const Expression &rhs) {
+    return Expression::combine(std::move(lhs), rhs, Expression::OpCode::Add);
+}
+
+// ___________________________________________________________________________
+Expression operator-(Expression lhs, const Expression &rhs) {
+    return Expression::combine(std::move(lhs), rhs, Expression::OpCode::Subtract);
+}
+
+// ___________________________________________________________________________
+Expression operator*(Expression lhs, const Expression &rhs) {
+    return Expression::combine(std::move(lhs), rhs, Expression::OpCode::Multiply);
+}
+
+// ___________________________________________________________________________
+Expression operator/(Expression lhs, const Expression &rhs) {
+    return Expression::combine(std::move(lhs), rhs, Expression::OpCode::Divide);
+}
+
+// ___________________________________________________________________________
+Expression Expression::min(Expression lhs, const Expression &rhs) {
+    return combine(std::move(lhs), rhs, OpCode::Min);
+}
+
+// ___________________________________________________________________________
+Expression Expression::max(Expression lhs, const Expression &rhs) {
+    return combine(std::move(lhs), rhs, OpCode::Max);
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Run the postfix program on a fixed-size stack. Leaf instructions push a value, binary instructions replace the
+ * two topmost values by their result
+ * - The stack depth has been checked while building, so no bounds checks are needed here
+ */
+// ___________________________________________________________________________
+float Expression::evaluate(const ExpressionContext &context) const {
+    std::array<float, maxStackDepth> stack{};
+    size_t top = 0;
+
+    for (const auto& instruction: program_) {
+        switch (instruction.opCode) {
+            case OpCode::Constant:
+                stack[top++] = instruction.value;
+                break;
+
+            case OpCode::Input:
+                switch (static_cast<ExpressionInput>(instruction.operand)) {
+                    case ExpressionInput::ParentWidth:  stack[top++] = instruction.value * context.parentSize.x; break;
+                    case ExpressionInput::ParentHeight: stack[top++] = instruction.value * context.parentSize.y; break;
+                    case ExpressionInput::Width:        stack[top++] = instruction.value * context.size.x;       break;
+                    case ExpressionInput::Height:       stack[top++] = instruction.value * context.size.y;       break;
+                    case ExpressionInput::Sibling:      stack[top++] = 0;                                        break;
+                }
+                break;
+
+            case OpCode::Sibling:
+                stack[top++] = instruction.value * getSiblingSize(siblings_[instruction.operand], context.parent);
+                break;
+
+            default:
+                top--;
+                stack[top - 1] = apply(instruction.opCode, stack[top - 1], stack[top]);
+                break;
+        }
+    }
+
+    return stack[0];
+}
+
+// ___________________________________________________________________________
+unsigned Expression::getInputMask() const {
+    return inputMask_;
+}
+
+// ___________________________________________________________________________
+std::vector<std::string> Expression::getSiblingNames() const {
+    std::vector<std::string> names;
+    for (auto& sibling: siblings_) {
+        names.push_back(sibling.name);
+    }
+    return names;
+}
+
+// ___________________________________________________________________________
+size_t Expression::getMemoryUsage() const {
+    size_t memoryUsage = program_.capacity() * sizeof(Instruction) + siblings_.capacity() * sizeof(SiblingReference);
+    for (auto& sibling: siblings_) {
+        memoryUsage += getHeapBytes(sibling.name);
+    }
+    return memoryUsage;
+}
+
+// ___________________________________________________________________________
+Expression Expression::input(ExpressionInput input, float factor) {
+    Expression expression(0);
+    expression.program_[0] = {OpCode::Input, factor, static_cast<unsigned>(input)};
+    expression.inputMask_ = toInputMask(input);
+    return expression;
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Fold two constants into a single constant, so that, e.g., "48 + 2 * 8" costs a single instruction
+ * - Otherwise, append the right program to the left one. The sibling indices of the right program are shifted by the
+ * number of siblings of the left one
+ * - The right program runs on top of the left program's result, which determines the needed stack depth
+ */
+// ___________________________________________________________________________
+Expression Expression::combine(Expression lhs, const Expression &rhs, OpCode opCode) {
+    bool isLhsConstant = lhs.program_.size() == 1 and lhs.program_[0].opCode == OpCode::Constant;
+    bool isRhsConstant = rhs.program_.size() == 1 and rhs.program_[0].opCode == OpCode::Constant;
+    if (isLhsConstant and isRhsConstant) {
+        lhs.program_[0].value = apply(opCode, lhs.program_[0].value, rhs.program_[0].value);
+        return lhs;
+    }
+
+    unsigned stackDepth = std::max(lhs.stackDepth_, rhs.stackDepth_ + 1);
+    if (stackDepth > maxStackDepth) {
+        throw std::runtime_error("Expression is nested too deeply.");
+    }
+
+    auto siblingOffset = static_cast<unsigned>(lhs.siblings_.size());
+    for (auto instruction: rhs.program_) {
+        if (instruction.opCode == OpCode::Sibling) {
+            instruction.operand += siblingOffset;
+        }
+        lhs.program_.push_back(instruction);
+    }
+    lhs.program_.push_back({opCode, 0});
+    lhs.siblings_.insert(lhs.siblings_.end(), rhs.siblings_.begin(), rhs.siblings_.end());
+    lhs.inputMask_ |= rhs.inputMask_;
+    lhs.stackDepth_ = stackDepth;
+
+    return lhs;
+}
+
+// ___________________________________________________________________________
+float Expression::apply(OpCode opCode, float lhs, float rhs) {
+    switch (opCode) {
+        case OpCode::Add:      return lhs + rhs;
+        case OpCode::Subtract: return lhs - rhs;
+        case OpCode::Multiply: return lhs * rhs;
+        case OpCode::Divide:   return rhs != 0 ? lhs / rhs : 0;
+        case OpCode::Min:      return std::min(lhs, rhs);
+        case OpCode::Max:      return std::max(lhs, rhs);
+        default:               return 0;
+    }
+}
+
+// ___________________________________________________________________________
+float Expression::getSiblingSize(const SiblingReference &sibling, Container *parent) const {
+    Container* container = Container::resolve(sibling.handle);
+
+    // Look the sibling up by name only once. Afterward, the cached handle is used until the sibling is removed
+    if (!container and parent) {
+        try {
+            sibling.handle = parent->findContainer(sibling.name);
+            container = Container::resolve(sibling.handle);
+        } catch (const std::runtime_error&) {
+            if (!sibling.isMissingReported) {
+                std::cerr << "Expression references unknown sibling container '" << sibling.name << "'." << std::endl;
+                sibling.isMissingReported = true;
+            }
+        }
+    }
+
+    if (!container) {
+        return 0;
+    }
+    return sibling.isWidth ? container->getSize().x : container->getSize().y;
+}
@@ -0,0 +1,127 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_EXPRESSION_H
+#define SWIFTIFYSFML_V0_1_EXPRESSION_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Enumerations.h"
+#include "SlotMap.h"
+
+// Forward declaration of the container class
+class Container;
+
+/*
+ * ExpressionContext struct. Values an expression is evaluated with. The parent is used to look up sibling containers.
+ */
+struct ExpressionContext {
+    sf::Vector2f parentSize;
+    sf::Vector2f size;
+    Container* parent = nullptr;
+};
+
+/*
+ * Expression class. Arithmetic expression over pixel values and the sizes of the parent, the container itself and
+ * sibling containers, e.g., "48px plus 10% of the parent height":
+ *
+ *     Expression height = 48 + Expression::parentHeight(0.1f);
+ *
+ * Expressions are compiled while they are built. Each operator appends to a flat postfix program and constant
+ * subexpressions are folded right away, so evaluating is a single pass over a short instruction vector. The inputs
+ * an expression reads are tracked as a mask, so that containers only re-evaluate the expressions affected by a change.
+ */
+class Expression {
+public:
+    // Constant expression in pixels. Implicit, so that numbers can be used directly in arithmetic
+    Expression(float pixels);
+
+    // Scaled size of the parent container
+    static Expression parentWidth(float factor = 1);
+    static Expression parentHeight(float factor = 1);
+
+    // Scaled size of the container itself. Only available for padding and spacing
+    static Expression width(float factor = 1);
+    static Expression height(float factor = 1);
+
+    // Scaled size of a sibling container specified by its name. The name is looked up on first evaluation only
+    static Expression siblingWidth(const std::string& name, float factor = 1);
+    static Expression siblingHeight(const std::string& name, float factor = 1);
+
+    // Arithmetic operators. A division by zero evaluates to zero
+    friend Expression operator+(Expression lhs, const Expression& rhs);
+    friend Expression operator-(Expression lhs, const Expression& rhs);
+    friend Expression operator*(Expression lhs, const Expression& rhs);
+    friend Expression operator/(Expression lhs, const Expression& rhs);
+
+    // Smaller and larger value of two expressions
+    static Expression min(Expression lhs, const Expression& rhs);
+    static Expression max(Expression lhs, const Expression& rhs);
+
+    // Compute the value of the expression
+    [[nodiscard]] float evaluate(const ExpressionContext& context) const;
+
+    // Get the inputs the expression depends on as a mask of ExpressionInput bits
+    [[nodiscard]] unsigned getInputMask() const;
+
+    // Get the names of the referenced siblings
+    [[nodiscard]] std::vector<std::string> getSiblingNames() const;
+
+    // Get the heap memory used by the program and the sibling references in bytes
+    [[nodiscard]] size_t getMemoryUsage() const;
+
+private:
+    // Instructions of the postfix program. Input and sibling instructions push their value scaled by the factor
+    enum class OpCode : std::uint8_t {
+        Constant,
+        Input,
+        Sibling,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Min,
+        Max
+    };
+
+    struct Instruction {
+        OpCode opCode;
+        float value;
+        unsigned operand = 0;
+    };
+
+    // Sibling referenced by name. The handle is resolved on first evaluation and cached. A missing sibling is looked
+    // up again on every evaluation, since it may be added later, but only reported once
+    struct SiblingReference {
+        std::string name;
+        bool isWidth;
+        mutable Handle<Container> handle;
+        mutable bool isMissingReported = false;
+    };
+
+    // Maximum number of intermediate values during evaluation
+    static constexpr unsigned maxStackDepth = 16;
+
+    // Expression made of a single input instruction
+    static Expression input(ExpressionInput input, float factor);
+
+    // Append the other program and a binary instruction. Folds the operation if both sides are constant
+    static Expression combine(Expression lhs, const Expression& rhs, OpCode opCode);
+
+    // Apply a binary instruction to two values
+    static float apply(OpCode opCode, float lhs, float rhs);
+
+    // Get the size of a referenced sibling. Looks the sibling up by name if the cached handle is invalid
+    [[nodiscard]] float getSiblingSize(const SiblingReference& sibling, Container* parent) const;
+
+    // Compiled program, referenced siblings, inputs and the stack depth needed for evaluation
+    std::vector<Instruction> program_;
+    std::vector<SiblingReference> siblings_;
+    unsigned inputMask_ = 0;
+    unsigned stackDepth_ = 1;
+};
+
+#endif //SWIFTIFYSFML_V0_1_EXPRESSION_H
@@ -0,0 +1,420 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "FocusManager.h"
+#include "Container.h"
+
+#include <cmath>
+#include <limits>
+
+// ___________________________________________________________________________
+FocusManager::FocusManager(Container &root) : root_(root) {
+    root_.focusManager_ = this;
+    updateSubtree(root_);
+}
+
+// ___________________________________________________________________________
+FocusManager::~FocusManager() {
+    if (root_.focusManager_ == this) {
+        root_.focusManager_ = nullptr;
+    }
+}
+
+// ___________________________________________________________________________
+bool FocusManager::setFocus(UIComponentHandle component) {
+    UIComponent* resolvedComponent = UIComponent::resolve(component);
+    if (!resolvedComponent or !chain_.count(resolvedComponent)) {
+        return false;
+    }
+
+    changeFocus(resolvedComponent);
+    return true;
+}
+
+// ___________________________________________________________________________
+void FocusManager::clearFocus() {
+    changeFocus(nullptr);
+}
+
+// ___________________________________________________________________________
+UIComponentHandle FocusManager::getFocus() const {
+    return focused_ ? focused_->getHandle() : UIComponentHandle();
+}
+
+// ___________________________________________________________________________
+void FocusManager::focusNext() {
+    // Visit each component at most once, starting after the focused one
+    UIComponent* component = focused_ ? chain_.at(focused_).next : first_;
+    for (size_t step = 0; step < chain_.size(); step++) {
+        if (!component) {
+            component = first_;
+        }
+        if (canFocus(*component)) {
+            changeFocus(component);
+            return;
+        }
+        component = chain_.at(component).next;
+    }
+}
+
+// ___________________________________________________________________________
+void FocusManager::focusPrevious() {
+    // Visit each component at most once, starting before the focused one
+    UIComponent* component = focused_ ? chain_.at(focused_).previous : last_;
+    for (size_t step = 0; step < chain_.size(); step++) {
+        if (!component) {
+            component = last_;
+        }
+        if (canFocus(*component)) {
+            changeFocus(component);
+            return;
+        }
+        component = chain_.at(component).previous;
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Without focus, fall back to the first focusable component
+ * - Only components whose center lies ahead in the direction are candidates
+ * - The distance across the direction counts twice, so that components in line are preferred over closer ones off
+ * to the side. Ties go to the earlier component in the chain
+ */
+// ___________________________________________________________________________
+void FocusManager::focusInDirection(sf::Vector2f direction) {
+    if (!focused_) {
+        focusNext();
+        return;
+    }
+
+    auto center = [](const UIComponent& component) { return component.getPosition() + component.getSize() / 2.f; };
+    sf::Vector2f origin = center(*focused_);
+
+    UIComponent* closest = nullptr;
+    float closestScore = std::numeric_limits<float>::max();
+    for (UIComponent* component = first_; component; component = chain_.at(component).next) {
+        if (component == focused_ or !canFocus(*component)) {
+            continue;
+        }
+
+        sf::Vector2f offset = center(*component) - origin;
+        float along = offset.x * direction.x + offset.y * direction.y;
+        float across = std::abs(offset.x * direction.y - offset.y * direction.x);
+        if (along <= 0) {
+            continue;
+        }
+
+        float score = along + 2 * across;
+        if (score < closestScore) {
+            closest = component;
+            closestScore = score;
+        }
+    }
+
+    if (closest) {
+        changeFocus(closest);
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Mouse button presses focus the component under the cursor and are passed on to the tree afterward
+ * - Key and text events go to the focused component first, then to the key callbacks of its parent containers. This
+ * only visits the path from the component to the root
+ * - Unhandled Tab and arrow key presses move the focus. Without focus, Tab focuses the first component and all other
+ * events are left to the tree
+ * - The tab character SFML sends right after a Tab press that moved the focus is dropped. Otherwise, the newly
+ * focused component would receive it as text
+ */
+// ___________________________________________________________________________
+bool FocusManager::handleEvent(const sf::Event &event) {
+    if (event.type == sf::Event::MouseButtonPressed) {
+        sf::Vector2f mousePosition(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y));
+        for (UIComponent* component = first_; component; component = chain_.at(component).next) {
+            if (canFocus(*component) and
+                sf::FloatRect(component->getPosition(), component->getSize()).contains(mousePosition)) {
+                changeFocus(component);
+                break;
+            }
+        }
+        return false;
+    }
+
+    if (event.type != sf::Event::KeyPressed and event.type != sf::Event::KeyReleased and
+        event.type != sf::Event::TextEntered) {
+        return false;
+    }
+
+    // Drop the tab character of a Tab press that moved the focus. Any other event ends the wait for it
+    if (isTabTextPending_) {
+        isTabTextPending_ = false;
+        if (event.type == sf::Event::TextEntered and event.text.unicode == '\t') {
+            return true;
+        }
+    }
+
+    if (focused_) {
+        if (focused_->isEnabled() and focused_->handleEvent(event)) {
+            return true;
+        }
+        for (Container* container = focused_->parent_; container; container = container->parent_) {
+            if (container->isEnabled_ and container->callbacks_ and
+                (*container->callbacks_)[static_cast<size_t>(CallbackType::Key)]) {
+                (*container->callbacks_)[static_cast<size_t>(CallbackType::Key)](event);
+                return true;
+            }
+        }
+    }
+
+    if (event.type != sf::Event::KeyPressed) {
+        return focused_ != nullptr;
+    }
+
+    sf::Vector2f direction;
+    switch (event.key.code) {
+        case sf::Keyboard::Tab:
+            event.key.shift ? focusPrevious() : focusNext();
+            isTabTextPending_ = true;
+            return true;
+        case sf::Keyboard::Left:
+            direction = sf::Vector2f(-1, 0);
+            break;
+        case sf::Keyboard::Right:
+            direction = sf::Vector2f(1, 0);
+            break;
+        case sf::Keyboard::Up:
+            direction = sf::Vector2f(0, -1);
+            break;
+        case sf::Keyboard::Down:
+            direction = sf::Vector2f(0, 1);
+            break;
+        default:
+            return focused_ != nullptr;
+    }
+
+    // Arrow keys only navigate once something is focused
+    if (!focused_) {
+        return false;
+    }
+    focusInDirection(direction);
+    return true;
+}
+
+// ___________________________________________________________________________
+size_t FocusManager::getFocusableCount() const {
+    return chain_.size();
+}
+
+// ___________________________________________________________________________
+size_t FocusManager::getMemoryUsage() const {
+    // Each node holds the key, the link and the pointer to the next node of its bucket
+    size_t nodeBytes = sizeof(std::pair<const UIComponent* const, Link>) + sizeof(void*);
+    return chain_.size() * nodeBytes + chain_.bucket_count() * sizeof(void*);
+}
+
+// ___________________________________________________________________________
+void FocusManager::addElement(const Container &parent, size_t index) {
+    std::vector<UIComponent*> components = getFocusables(parent, index);
+    if (!components.empty()) {
+        link(findLinkedBefore(parent, index), components);
+    }
+}
+
+// ___________________________________________________________________________
+void FocusManager::removeElement(const Container &parent, size_t index) {
+    for (UIComponent* component: getFocusables(parent, index)) {
+        unlink(component);
+    }
+    dropUnlinkedFocus();
+}
+
+// ___________________________________________________________________________
+void FocusManager::moveElement(const Container &parent, size_t index) {
+    std::vector<UIComponent*> components = getFocusables(parent, index);
+    for (UIComponent* component: components) {
+        unlink(component);
+    }
+    if (!components.empty()) {
+        link(findLinkedBefore(parent, index), components);
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Unlink all focusable components of the subtree, then link them again in their current order after the last
+ * component before the container. The focused component is linked again as well, so the focus is kept
+ * - The root container has nothing before it
+ */
+// ___________________________________________________________________________
+void FocusManager::updateSubtree(const Container &container) {
+    std::vector<UIComponent*> components;
+    collectFocusables(container, components);
+    for (UIComponent* component: components) {
+        unlink(component);
+    }
+
+    UIComponent* previous = nullptr;
+    if (&container != &root_ and container.parent_) {
+        previous = findLinkedBefore(*container.parent_, container.parent_->findElementIndex(&container));
+    }
+    link(previous, components);
+
+    // Components that stopped being focusable meanwhile have been dropped from the subtree's masks
+    dropUnlinkedFocus();
+}
+
+// ___________________________________________________________________________
+void FocusManager::addFocusable(UIComponent &component) {
+    if (chain_.count(&component) or !component.parent_) {
+        return;
+    }
+
+    const Container& parent = *component.parent_;
+    link(findLinkedBefore(parent, parent.findElementIndex(&component)), {&component});
+}
+
+// ___________________________________________________________________________
+void FocusManager::removeFocusable(UIComponent &component) {
+    unlink(&component);
+    dropUnlinkedFocus();
+}
+
+// ___________________________________________________________________________
+void FocusManager::collectFocusables(const Container &container, std::vector<UIComponent*> &components) {
+    if (!(container.subtreeCallbackMask_ & focusableMask)) {
+        return;
+    }
+    for (auto& element: container.elements_) {
+        std::visit([&components](auto& el) { collectFocusables(*el, components); }, element);
+    }
+}
+
+// ___________________________________________________________________________
+void FocusManager::collectFocusables(UIComponent &component, std::vector<UIComponent*> &components) {
+    if (component.getCallbackMask() & focusableMask) {
+        components.push_back(&component);
+    }
+}
+
+// ___________________________________________________________________________
+UIComponent *FocusManager::findLastLinked(const Container &container) const {
+    if (!(container.subtreeCallbackMask_ & focusableMask)) {
+        return nullptr;
+    }
+    for (size_t index = container.elements_.size(); index-- > 0;) {
+        UIComponent* component = std::visit([this](auto& el) { return findLastLinked(*el); },
+                                            container.elements_[index]);
+        if (component) {
+            return component;
+        }
+    }
+    return nullptr;
+}
+
+// ___________________________________________________________________________
+UIComponent *FocusManager::findLastLinked(UIComponent &component) const {
+    return chain_.count(&component) ? &component : nullptr;
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Search the earlier elements of the parent from back to front. Subtrees without focusable components are
+ * skipped by their masks, so this usually ends at the closest earlier focusable component
+ * - If there is none, continue with the elements before the parent in its own parent, up to the root container
+ */
+// ___________________________________________________________________________
+UIComponent *FocusManager::findLinkedBefore(const Container &parent, size_t index) const {
+    const Container* container = &parent;
+    while (true) {
+        for (size_t earlierIndex = index; earlierIndex-- > 0;) {
+            UIComponent* component = std::visit([this](auto& el) { return findLastLinked(*el); },
+                                                container->elements_[earlierIndex]);
+            if (component) {
+                return component;
+            }
+        }
+
+        if (container == &root_ or !container->parent_) {
+            return nullptr;
+        }
+        index = container->parent_->findElementIndex(container);
+        container = container->parent_;
+    }
+}
+
+// ___________________________________________________________________________
+std::vector<UIComponent*> FocusManager::getFocusables(const Container &parent, size_t index) {
+    std::vector<UIComponent*> components;
+    if (index < parent.elements_.size()) {
+        std::visit([&components](auto& el) { collectFocusables(*el, components); }, parent.elements_[index]);
+    }
+    return components;
+}
+
+// ___________________________________________________________________________
+void FocusManager::link(UIComponent *previous, const std::vector<UIComponent*> &components) {
+    if (components.empty()) {
+        return;
+    }
+    UIComponent* next = previous ? chain_.at(previous).next : first_;
+
+    for (UIComponent* component: components) {
+        chain_[component] = {previous, nullptr};
+        (previous ? chain_.at(previous).next : first_) = component;
+        previous = component;
+    }
+
+    if (previous) {
+        chain_.at(previous).next = next;
+    }
+    (next ? chain_.at(next).previous : last_) = previous;
+}
+
+// ___________________________________________________________________________
+bool FocusManager::unlink(UIComponent *component) {
+    auto entry = chain_.find(component);
+    if (entry == chain_.end()) {
+        return false;
+    }
+
+    Link componentLink = entry->second;
+    (componentLink.previous ? chain_.at(componentLink.previous).next : first_) = componentLink.next;
+    (componentLink.next ? chain_.at(componentLink.next).previous : last_) = componentLink.previous;
+    chain_.erase(entry);
+    return true;
+}
+
+// ___________________________________________________________________________
+void FocusManager::dropUnlinkedFocus() {
+    if (focused_ and !chain_.count(focused_)) {
+        UIComponent* previousFocus = focused_;
+        focused_ = nullptr;
+        previousFocus->onFocusChanged(false);
+    }
+}
+
+// ___________________________________________________________________________
+void FocusManager::changeFocus(UIComponent *component) {
+    if (component == focused_) {
+        return;
+    }
+
+    UIComponent* previousFocus = focused_;
+    focused_ = component;
+    if (previousFocus) {
+        previousFocus->onFocusChanged(false);
+    }
+    if (focused_) {
+        focused_->onFocusChanged(true);
+    }
+}
+
+// ___________________________________________________________________________
+bool FocusManager::canFocus(const UIComponent &component) {
+    return component.isVisible() and component.isEnabled();
+}
@@ -0,0 +1,130 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_FOCUSMANAGER_H
+#define SWIFTIFYSFML_V0_1_FOCUSMANAGER_H
+
+#include <SFML/Graphics.hpp>
+#include <unordered_map>
+#include <vector>
+#include "UIComponent.h"
+
+/*
+ * FocusManager class. Keeps track of the keyboard focus inside the tree of a root container. The focusable UI
+ * components form a focus chain in layout order, which is a linked list updated incrementally when elements are
+ * added, removed or moved. Key and text events are routed straight to the focused component and then up through its
+ * parent containers, so dispatching them doesn't depend on the size of the tree. Tab and Shift+Tab follow the chain,
+ * the arrow keys move to the closest focusable component in their direction.
+ */
+class FocusManager {
+public:
+    // Constructor and destructor. Registers with the root container and builds the chain from its current content.
+    // The root container has to outlive the focus manager
+    explicit FocusManager(Container& root);
+    ~FocusManager();
+
+    // Delete copy constructor and copy assignment operator. The root container refers to the focus manager
+    FocusManager(const FocusManager&) = delete;
+    FocusManager& operator=(const FocusManager&) = delete;
+
+    // Move the focus to a UI component. Returns false if it isn't a focusable component in the tree
+    bool setFocus(UIComponentHandle component);
+    void clearFocus();
+
+    // Get the focused UI component. The handle is invalid if nothing is focused
+    [[nodiscard]] UIComponentHandle getFocus() const;
+
+    // Move the focus to the next or previous visible and enabled component in the chain, wrapping around at the ends
+    void focusNext();
+    void focusPrevious();
+
+    // Move the focus to the closest visible and enabled component in a direction, e.g., (1, 0) for right. Keeps the
+    // focus if there is none. Compares the focusable components only, not the whole tree
+    void focusInDirection(sf::Vector2f direction);
+
+    // Route a key or text event to the focused component, then to the key callbacks of its parent containers until
+    // one handles it. Unhandled Tab and arrow key presses move the focus. A mouse button press focuses the focusable
+    // component under the cursor, but isn't handled. Returns true if the event has been handled. Without focus, only
+    // Tab is handled, so that the other key events can still be passed through the tree. The tab character following
+    // a Tab press that moved the focus is handled without being passed on
+    bool handleEvent(const sf::Event& event);
+
+    // Get the number of components in the focus chain and the memory used by it in bytes
+    [[nodiscard]] size_t getFocusableCount() const;
+    [[nodiscard]] size_t getMemoryUsage() const;
+
+    // --- Chain updates. Called by the containers and UI components of the tree ---
+
+    // Link the focusable components in the subtree of the element at the index of the parent container
+    void addElement(const Container& parent, size_t index);
+
+    // Unlink the components in the subtree of the element at the index. Clears the focus if it is among them
+    void removeElement(const Container& parent, size_t index);
+
+    // Link the components in the subtree of the element at its new index again. Keeps the focus
+    void moveElement(const Container& parent, size_t index);
+
+    // Link all components nested in the container again, e.g., after its elements have been reordered or a batch has
+    // been committed. Keeps the focus
+    void updateSubtree(const Container& container);
+
+    // Link or unlink a single UI component that became focusable or stopped being focusable
+    void addFocusable(UIComponent& component);
+    void removeFocusable(UIComponent& component);
+
+private:
+    // Neighbors of a component in the focus chain
+    struct Link {
+        UIComponent* previous = nullptr;
+        UIComponent* next = nullptr;
+    };
+
+    // Collect the focusable components nested in an element in layout order. Subtrees without focusable components
+    // are skipped by their callback masks
+    static void collectFocusables(const Container& container, std::vector<UIComponent*>& components);
+    static void collectFocusables(UIComponent& component, std::vector<UIComponent*>& components);
+
+    // Get the last linked component in an element's subtree. Returns nullptr if there is none
+    [[nodiscard]] UIComponent* findLastLinked(const Container& container) const;
+    [[nodiscard]] UIComponent* findLastLinked(UIComponent& component) const;
+
+    // Get the last linked component before the element at the index of the parent in layout order, searching the
+    // parent's earlier elements first and then those of its ancestors. Returns nullptr if there is none
+    [[nodiscard]] UIComponent* findLinkedBefore(const Container& parent, size_t index) const;
+
+    // Get the focusable components of the element at the index of the parent
+    static std::vector<UIComponent*> getFocusables(const Container& parent, size_t index);
+
+    // Insert the components into the chain after the previous component, or at the front if it is nullptr
+    void link(UIComponent* previous, const std::vector<UIComponent*>& components);
+
+    // Remove a component from the chain. Returns false if it wasn't linked
+    bool unlink(UIComponent* component);
+
+    // Clear the focus if the focused component isn't linked anymore
+    void dropUnlinkedFocus();
+
+    // Move the focus to a linked component and notify both components
+    void changeFocus(UIComponent* component);
+
+    // Returns true if the component can receive the focus
+    static bool canFocus(const UIComponent& component);
+
+    // Root container of the tree
+    Container& root_;
+
+    // Focus chain in layout order
+    std::unordered_map<const UIComponent*, Link> chain_;
+    UIComponent* first_ = nullptr;
+    UIComponent* last_ = nullptr;
+
+    // Focused component. Always linked
+    UIComponent* focused_ = nullptr;
+
+    // Flag indicating that a Tab press moved the focus. The tab character entered with it is dropped, so that it
+    // doesn't reach the newly focused component
+    bool isTabTextPending_ = false;
+};
+
+#endif //SWIFTIFYSFML_V0_1_FOCUSMANAGER_H
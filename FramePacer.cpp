@@ -0,0 +1,269 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// Weight of the latest frame in the smoothed work. Averages over roughly the last ten frames
+static constexpr float workSmoothing = 0.2f;
+
+// Frames the governor waits after changing the level, so that the smoothed work reflects the change
+static constexpr std::uint64_t settleFrames = 10;
+
+// Consecutive frames the smoothed work has to be above the degrade threshold before degrading, and the multiple of
+// the target a single frame is clamped to when smoothing. Together, they keep single long frames from degrading
+static constexpr std::uint64_t busyFramesToDegrade = 5;
+static constexpr float maxFrameWorkRatio = 2;
+
+// Calm frames before a degradation is restored first, and the most it waits after being applied again repeatedly
+static constexpr std::uint64_t initialRestoreDelay = 120;
+static constexpr std::uint64_t maxRestoreDelay = 3840;
+
+// ___________________________________________________________________________
+sf::Time FrameBudget::getWork() const {
+    return dispatch + update + draw + syntheticLoad;
+}
+
+// ___________________________________________________________________________
+sf::Time FrameBudget::getHeadroom() const {
+    return target - getWork();
+}
+
+// ___________________________________________________________________________
+bool FrameBudget::isOverBudget() const {
+    return getWork() > target;
+}
+
+// ___________________________________________________________________________
+FramePacer::FramePacer() {
+    target_ = sf::seconds(1.f / 60);
+}
+
+// ___________________________________________________________________________
+void FramePacer::setTargetFrameTime(sf::Time target) {
+    if (target <= sf::Time::Zero) {
+        std::cerr << "Target frame time has to be positive. Keeping the previous target." << std::endl;
+        return;
+    }
+
+    target_ = target;
+}
+
+// ___________________________________________________________________________
+void FramePacer::setVerticalSyncEnabled(bool isEnabled) {
+    isVerticalSyncEnabled_ = isEnabled;
+}
+
+// ___________________________________________________________________________
+void FramePacer::setThresholds(float degradeRatio, float restoreRatio) {
+    if (restoreRatio <= 0 or restoreRatio >= degradeRatio) {
+        std::cerr << "Restore threshold has to be positive and below the degrade threshold. Keeping the previous "
+                     "thresholds." << std::endl;
+        return;
+    }
+
+    degradeRatio_ = degradeRatio;
+    restoreRatio_ = restoreRatio;
+}
+
+// ___________________________________________________________________________
+size_t FramePacer::addDegradation(std::string name, std::function<void(bool)> apply) {
+    degradations_.push_back({std::move(name), std::move(apply), initialRestoreDelay});
+    return degradations_.size() - 1;
+}
+
+// ___________________________________________________________________________
+void FramePacer::setSyntheticLoad(std::function<sf::Time(std::uint64_t)> load) {
+    syntheticLoad_ = std::move(load);
+}
+
+// ___________________________________________________________________________
+void FramePacer::beginFrame() {
+    currentFrame_ = FrameBudget();
+    frameClock_.restart();
+    phaseClock_.restart();
+}
+
+// ___________________________________________________________________________
+void FramePacer::endDispatch() {
+    currentFrame_.dispatch = phaseClock_.restart();
+}
+
+// ___________________________________________________________________________
+void FramePacer::endUpdate() {
+    currentFrame_.update = phaseClock_.restart();
+}
+
+// ___________________________________________________________________________
+void FramePacer::endDraw() {
+    currentFrame_.draw = phaseClock_.restart();
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Everything since the end of drawing has been presenting, i.e., displaying the windows
+ * - The synthetic load is slept, so that it delays the frame like real work would, and counted as work
+ * - Without vertical synchronization, nothing waits for the display, so the rest of the target frame time is slept
+ * here. With it, presenting has already waited
+ */
+// ___________________________________________________________________________
+void FramePacer::endFrame() {
+    currentFrame_.present = phaseClock_.restart();
+
+    if (syntheticLoad_) {
+        sf::Time load = syntheticLoad_(frameCount_);
+        if (load > sf::Time::Zero) {
+            sf::sleep(load);
+        }
+        currentFrame_.syntheticLoad = phaseClock_.restart();
+    }
+
+    if (!isVerticalSyncEnabled_) {
+        sf::Time remaining = target_ - frameClock_.getElapsedTime();
+        if (remaining > sf::Time::Zero) {
+            sf::sleep(remaining);
+        }
+        currentFrame_.present += phaseClock_.restart();
+    }
+
+    currentFrame_.target = target_;
+    recordFrame(currentFrame_);
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Smooth the work over the recent frames. Each frame is clamped to twice the target first, so that a single long
+ * frame, e.g., loading a screen, can't raise the average on its own
+ * - After a change of the level, wait until the smoothed work reflects it
+ * - Degrade one step once the smoothed work has been above the degrade threshold for a few frames. Restore one step
+ * once it has been below the restore threshold for the restore delay of the last applied degradation. Work between
+ * both thresholds keeps the level
+ */
+// ___________________________________________________________________________
+void FramePacer::recordFrame(const FrameBudget &frame) {
+    lastFrame_ = frame;
+    frameCount_++;
+    if (frame.isOverBudget()) {
+        overBudgetCount_++;
+    }
+
+    float target = frame.target.asSeconds();
+    float work = std::min(frame.getWork().asSeconds(), target * maxFrameWorkRatio);
+    averageWork_ = frameCount_ == 1 ? work : averageWork_ + (work - averageWork_) * workSmoothing;
+
+    framesSinceChange_++;
+    if (framesSinceChange_ < settleFrames) {
+        return;
+    }
+
+    if (averageWork_ > target * degradeRatio_) {
+        calmFrames_ = 0;
+        busyFrames_++;
+        if (busyFrames_ >= busyFramesToDegrade and level_ < degradations_.size()) {
+            degrade();
+        }
+    } else if (averageWork_ < target * restoreRatio_) {
+        busyFrames_ = 0;
+        calmFrames_++;
+        if (level_ > 0 and calmFrames_ >= degradations_[level_ - 1].restoreDelay) {
+            restore();
+        }
+    } else {
+        busyFrames_ = 0;
+        calmFrames_ = 0;
+    }
+}
+
+// ___________________________________________________________________________
+const FrameBudget &FramePacer::getLastFrame() const {
+    return lastFrame_;
+}
+
+// ___________________________________________________________________________
+sf::Time FramePacer::getAverageWork() const {
+    return sf::seconds(averageWork_);
+}
+
+// ___________________________________________________________________________
+std::uint64_t FramePacer::getFrameCount() const {
+    return frameCount_;
+}
+
+// ___________________________________________________________________________
+std::uint64_t FramePacer::getOverBudgetCount() const {
+    return overBudgetCount_;
+}
+
+// ___________________________________________________________________________
+size_t FramePacer::getDegradationCount() const {
+    return degradations_.size();
+}
+
+// ___________________________________________________________________________
+size_t FramePacer::getDegradationLevel() const {
+    return level_;
+}
+
+// ___________________________________________________________________________
+bool FramePacer::isDegraded(size_t degradation) const {
+    if (degradation >= degradations_.size()) {
+        throw std::runtime_error("Degradation index " + std::to_string(degradation) + " is out of range.");
+    }
+    return degradation < level_;
+}
+
+// ___________________________________________________________________________
+void FramePacer::print(std::ostream &stream) const {
+    stream << "Frame " << frameCount_ << ": dispatch " << lastFrame_.dispatch.asMicroseconds() << " us, update "
+           << lastFrame_.update.asMicroseconds() << " us, draw " << lastFrame_.draw.asMicroseconds()
+           << " us, synthetic " << lastFrame_.syntheticLoad.asMicroseconds() << " us, present "
+           << lastFrame_.present.asMicroseconds() << " us" << std::endl;
+    stream << "Work: last " << lastFrame_.getWork().asMicroseconds() << " us, average "
+           << getAverageWork().asMicroseconds() << " us, target " << target_.asMicroseconds() << " us, "
+           << overBudgetCount_ << " of " << frameCount_ << " frames over budget" << std::endl;
+    stream << "Degraded " << level_ << " of " << degradations_.size() << ":";
+    for (size_t index = 0; index < level_; index++) {
+        stream << " " << degradations_[index].name;
+    }
+    stream << std::endl;
+}
+
+// ___________________________________________________________________________
+void FramePacer::degrade() {
+    Degradation& degradation = degradations_[level_];
+
+    // Applied again before it would have been restored once more, so restoring it didn't leave enough headroom
+    if (isLastChangeRestore_ and framesSinceChange_ < degradation.restoreDelay) {
+        degradation.restoreDelay = std::min(degradation.restoreDelay * 2, maxRestoreDelay);
+    }
+
+    level_++;
+    busyFrames_ = 0;
+    calmFrames_ = 0;
+    framesSinceChange_ = 0;
+    isLastChangeRestore_ = false;
+    if (degradation.apply) {
+        degradation.apply(true);
+    }
+}
+
+// ___________________________________________________________________________
+void FramePacer::restore() {
+    level_--;
+    busyFrames_ = 0;
+    calmFrames_ = 0;
+    framesSinceChange_ = 0;
+    isLastChangeRestore_ = true;
+
+    Degradation& degradation = degradations_[level_];
+    if (degradation.apply) {
+        degradation.apply(false);
+    }
+}
@@ -0,0 +1,137 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_FRAMEPACER_H
+#define SWIFTIFYSFML_V0_1_FRAMEPACER_H
+
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*
+ * FrameBudget struct. Time spent in the phases of a frame, compared to the target frame time. Presenting isn't work:
+ * it contains waiting for the display with vertical synchronization and the pacing sleep without it.
+ */
+struct FrameBudget {
+    sf::Time target;
+    sf::Time dispatch;
+    sf::Time update;
+    sf::Time draw;
+    sf::Time syntheticLoad;
+    sf::Time present;
+
+    // Get the time spent working on the frame, and the time left of the target, which is negative if it is exceeded
+    [[nodiscard]] sf::Time getWork() const;
+    [[nodiscard]] sf::Time getHeadroom() const;
+    [[nodiscard]] bool isOverBudget() const;
+};
+
+/*
+ * FramePacer class. Measures the phases of every drawn frame against a target frame time, and paces the main loop to
+ * that target when the display doesn't, i.e., without vertical synchronization. A governor degrades optional work
+ * when the frames exceed their budget and restores it when there is headroom. The optional work is registered as
+ * degradations, which are applied in the order they were added and restored in reverse. A degradation applied again
+ * soon after it was restored waits twice as long for its next restore, so the governor settles instead of switching
+ * back and forth.
+ *
+ * For testing the governor, a synthetic load can be spent in every frame, or frames can be recorded directly.
+ */
+class FramePacer {
+public:
+    // Constructor and destructor. Targets 60 frames per second without vertical synchronization by default
+    FramePacer();
+    ~FramePacer() = default;
+
+    // Set the target frame time. With vertical synchronization, it should be the refresh interval of the display
+    void setTargetFrameTime(sf::Time target);
+
+    // Set if the window waits for the display when presenting. SFML can't query it, so it has to match the window
+    void setVerticalSyncEnabled(bool isEnabled);
+
+    // Set the average work, relative to the target, above which the governor degrades and below which it restores
+    void setThresholds(float degradeRatio, float restoreRatio);
+
+    // Add optional work that can be degraded. The function is called with true to degrade it and with false to
+    // restore it. Returns the index of the degradation
+    size_t addDegradation(std::string name, std::function<void(bool isDegraded)> apply);
+
+    // Spend a synthetic load in every frame, e.g., to verify that the governor degrades and restores. The function
+    // gets the index of the frame. An empty function removes the load
+    void setSyntheticLoad(std::function<sf::Time(std::uint64_t frame)> load);
+
+    // Mark the start of a frame and the end of its phases. Called by the main loop. The end of the frame spends the
+    // synthetic load, sleeps until the target frame time has passed without vertical synchronization, and records the
+    // frame
+    void beginFrame();
+    void endDispatch();
+    void endUpdate();
+    void endDraw();
+    void endFrame();
+
+    // Record a measured frame and let the governor react to it
+    void recordFrame(const FrameBudget& frame);
+
+    // Get the last recorded frame, the smoothed work of the recent frames, and the number of recorded frames and of
+    // those over budget
+    [[nodiscard]] const FrameBudget& getLastFrame() const;
+    [[nodiscard]] sf::Time getAverageWork() const;
+    [[nodiscard]] std::uint64_t getFrameCount() const;
+    [[nodiscard]] std::uint64_t getOverBudgetCount() const;
+
+    // Get the number of degradations and the number of currently applied ones
+    [[nodiscard]] size_t getDegradationCount() const;
+    [[nodiscard]] size_t getDegradationLevel() const;
+    [[nodiscard]] bool isDegraded(size_t degradation) const;
+
+    // Print the budget of the last frame, the average work and the applied degradations
+    void print(std::ostream& stream) const;
+
+private:
+    // Optional work and the number of calm frames it waits for before being restored
+    struct Degradation {
+        std::string name;
+        std::function<void(bool)> apply;
+        std::uint64_t restoreDelay = 0;
+    };
+
+    // Apply the next degradation or restore the last applied one
+    void degrade();
+    void restore();
+
+    // Target frame time, vertical synchronization and the thresholds of the governor
+    sf::Time target_;
+    bool isVerticalSyncEnabled_ = false;
+    float degradeRatio_ = 0.9f;
+    float restoreRatio_ = 0.5f;
+
+    // Degradations in order. The first level_ of them are applied
+    std::vector<Degradation> degradations_;
+    size_t level_ = 0;
+
+    // Frames the average has been above the degrade threshold and below the restore threshold, frames since the level
+    // last changed and if that change was a restore. Reacting again is held back until the average reflects the change
+    std::uint64_t busyFrames_ = 0;
+    std::uint64_t calmFrames_ = 0;
+    std::uint64_t framesSinceChange_ = 0;
+    bool isLastChangeRestore_ = false;
+
+    // Smoothed work, the last frame and the counters
+    float averageWork_ = 0;
+    FrameBudget lastFrame_;
+    std::uint64_t frameCount_ = 0;
+    std::uint64_t overBudgetCount_ = 0;
+
+    // Synthetic load spent in every frame
+    std::function<sf::Time(std::uint64_t)> syntheticLoad_;
+
+    // Phases of the current frame, measured by the clocks
+    FrameBudget currentFrame_;
+    sf::Clock frameClock_;
+    sf::Clock phaseClock_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_FRAMEPACER_H
@@ -0,0 +1,103 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "FramePacer.h"
+
+// Number of failed checks
+static int failureCount = 0;
+
+// ___________________________________________________________________________
+// Print a failed check and count it
+// ___________________________________________________________________________
+static void check(bool condition, const std::string& description) {
+    if (!condition) {
+        std::cerr << "FAILED: " << description << std::endl;
+        failureCount++;
+    }
+}
+
+// ___________________________________________________________________________
+// Record frames with the given work at the default target of 60 frames per second
+// ___________________________________________________________________________
+static void recordFrames(FramePacer& pacer, sf::Time work, size_t frameCount) {
+    for (size_t frame = 0; frame < frameCount; frame++) {
+        FrameBudget budget;
+        budget.target = sf::seconds(1.f / 60);
+        budget.syntheticLoad = work;
+        pacer.recordFrame(budget);
+    }
+}
+
+// ___________________________________________________________________________
+// Add three degradations that log their changes, e.g., "+0" when the first one is applied and "-0" when it is restored
+// ___________________________________________________________________________
+static void addDegradations(FramePacer& pacer, std::vector<std::string>& changes) {
+    for (size_t index = 0; index < 3; index++) {
+        pacer.addDegradation("Degradation" + std::to_string(index), [&changes, index](bool isDegraded) {
+            changes.push_back((isDegraded ? "+" : "-") + std::to_string(index));
+        });
+    }
+}
+
+// ___________________________________________________________________________
+static void testSustainedLoadDegradesAndRestoresInReverse() {
+    FramePacer pacer;
+    std::vector<std::string> changes;
+    addDegradations(pacer, changes);
+
+    // Frames of 25 ms exceed the target of 16.7 ms, so all degradations are applied one by one
+    recordFrames(pacer, sf::milliseconds(25), 300);
+    check(pacer.getDegradationLevel() == 3, "Sustained 25 ms frames apply all degradations");
+    check(changes == std::vector<std::string>({"+0", "+1", "+2"}), "Degradations are applied in order");
+
+    // Frames of 5 ms leave enough headroom, so the degradations are restored in reverse
+    recordFrames(pacer, sf::milliseconds(5), 1000);
+    check(pacer.getDegradationLevel() == 0, "Calm frames restore all degradations");
+    check(changes == std::vector<std::string>({"+0", "+1", "+2", "-2", "-1", "-0"}),
+          "Degradations are restored in reverse order");
+}
+
+// ___________________________________________________________________________
+static void testSingleSpikeKeepsLevel() {
+    FramePacer pacer;
+    std::vector<std::string> changes;
+    addDegradations(pacer, changes);
+
+    // A single long frame, e.g., loading a screen, between frames with headroom doesn't degrade anything
+    recordFrames(pacer, sf::milliseconds(8), 100);
+    recordFrames(pacer, sf::milliseconds(250), 1);
+    recordFrames(pacer, sf::milliseconds(8), 100);
+    check(pacer.getDegradationLevel() == 0, "A single 250 ms frame doesn't degrade");
+    check(changes.empty(), "No degradation is applied for a single spike");
+}
+
+// ___________________________________________________________________________
+static void testLoadBetweenThresholdsKeepsLevel() {
+    FramePacer pacer;
+    std::vector<std::string> changes;
+    addDegradations(pacer, changes);
+
+    // Degrade once, then stay between the restore and the degrade threshold
+    recordFrames(pacer, sf::milliseconds(25), 20);
+    size_t level = pacer.getDegradationLevel();
+    check(level > 0, "Sustained 25 ms frames degrade within 20 frames");
+    recordFrames(pacer, sf::milliseconds(12), 1000);
+    check(pacer.getDegradationLevel() == level, "Frames between both thresholds keep the level");
+}
+
+int main() {
+    testSustainedLoadDegradesAndRestoresInReverse();
+    testSingleSpikeKeepsLevel();
+    testLoadBetweenThresholdsKeepsLevel();
+
+    if (failureCount > 0) {
+        std::cerr << failureCount << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All frame pacer checks passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,258 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "ImmediateContext.h"
+
+#include <algorithm>
+#include <iostream>
+
+// ___________________________________________________________________________
+ImmediateContext::ImmediateContext(Container &root) {
+    root_.container = root.getHandle();
+}
+
+// ___________________________________________________________________________
+void ImmediateContext::begin() {
+    root_.declaredChildren = 0;
+    openNodes_.assign(1, &root_);
+}
+
+// ___________________________________________________________________________
+void ImmediateContext::end() {
+    if (openNodes_.size() != 1) {
+        std::cerr << "Immediate mode declarations are unbalanced. Closing " << openNodes_.size() - 1
+                  << " open containers." << std::endl;
+    }
+    while (openNodes_.size() > 1) {
+        endContainer();
+    }
+
+    removeUndeclaredChildren(root_);
+    openNodes_.clear();
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Reuse the container declared with the same key in the previous frame. If the key belonged to a UI component,
+ * the component is replaced
+ * - New containers are created with the declared size proportions, all other properties are set by the comparison
+ * with the defaults
+ * - Report and reset the click state
+ */
+// ___________________________________________________________________________
+bool ImmediateContext::beginContainer(const std::string &key, const ImmediateProperties &properties) {
+    if (openNodes_.empty()) {
+        throw std::runtime_error("Immediate mode declarations have to be made between begin and end.");
+    }
+
+    Node* node = reuseChild(key);
+    if (node and !Container::resolve(node->container)) {
+        Node& parent = *openNodes_.back();
+        removeChild(parent, --parent.declaredChildren);
+        node = nullptr;
+    }
+
+    if (!node) {
+        auto container = std::make_unique<Container>(key, properties.sizeProportions);
+        auto newNode = std::make_unique<Node>();
+        newNode->key = key;
+        newNode->container = container->getHandle();
+        newNode->properties.sizeProportions = properties.sizeProportions;
+        node = &insertChild(std::move(newNode), std::move(container), nullptr);
+    }
+
+    applyProperties(*Container::resolve(node->container), *node, properties);
+    node->declaredChildren = 0;
+    openNodes_.push_back(node);
+
+    bool wasClicked = node->wasClicked;
+    node->wasClicked = false;
+    return wasClicked;
+}
+
+// ___________________________________________________________________________
+void ImmediateContext::endContainer() {
+    if (openNodes_.size() <= 1) {
+        std::cerr << "endContainer has been called without a matching beginContainer." << std::endl;
+        return;
+    }
+
+    removeUndeclaredChildren(*openNodes_.back());
+    openNodes_.pop_back();
+}
+
+// ___________________________________________________________________________
+bool ImmediateContext::container(const std::string &key, const ImmediateProperties &properties) {
+    bool wasClicked = beginContainer(key, properties);
+    endContainer();
+    return wasClicked;
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - In the common case, the keys are declared in the same order as in the previous frame, so the child at the next
+ * position already has the key
+ * - Otherwise, search the children that haven't been declared yet in this frame. A match is moved to the next
+ * position, in the state and in the container
+ */
+// ___________________________________________________________________________
+ImmediateContext::Node *ImmediateContext::reuseChild(const std::string &key) {
+    Node& parent = *openNodes_.back();
+    auto& children = parent.children;
+    size_t position = parent.declaredChildren;
+
+    if (position < children.size() and children[position]->key == key) {
+        parent.declaredChildren++;
+        return children[position].get();
+    }
+
+    for (size_t index = position + 1; index < children.size(); index++) {
+        if (children[index]->key != key) {
+            continue;
+        }
+
+        Node& child = *children[index];
+        std::rotate(children.begin() + static_cast<std::ptrdiff_t>(position),
+                    children.begin() + static_cast<std::ptrdiff_t>(index),
+                    children.begin() + static_cast<std::ptrdiff_t>(index + 1));
+
+        Container* parentContainer = Container::resolve(parent.container);
+        if (Container::resolve(child.container)) {
+            parentContainer->moveElement(child.container, position);
+        } else if (UIComponent::resolve(child.component)) {
+            parentContainer->moveElement(child.component, position);
+        }
+
+        parent.declaredChildren++;
+        return &child;
+    }
+
+    return nullptr;
+}
+
+// ___________________________________________________________________________
+ImmediateContext::Node &ImmediateContext::insertChild(std::unique_ptr<Node> node,
+                                                      std::unique_ptr<Container> container,
+                                                      std::unique_ptr<UIComponent> component) {
+    Node& parent = *openNodes_.back();
+    Container* parentContainer = Container::resolve(parent.container);
+    size_t position = parent.declaredChildren++;
+
+    // Elements are added to the end and moved to their position, which is the end unless keys have been removed
+    if (container) {
+        parentContainer->addContainer(std::move(container));
+        parentContainer->moveElement(node->container, position);
+    } else {
+        parentContainer->addUIComponent(std::move(component));
+        parentContainer->moveElement(node->component, position);
+    }
+
+    parent.children.insert(parent.children.begin() + static_cast<std::ptrdiff_t>(position), std::move(node));
+    return *parent.children[position];
+}
+
+// ___________________________________________________________________________
+void ImmediateContext::applyProperties(Container &container, Node &node, const ImmediateProperties &properties) {
+    ImmediateProperties& previous = node.properties;
+
+    // Layout properties. Each setter invalidates the layout, so only the changed ones are set
+    if (properties.sizeProportions != previous.sizeProportions) {
+        container.setSizeProportions(properties.sizeProportions);
+    }
+    if (properties.paddingProportions != previous.paddingProportions) {
+        container.setPaddingProportions(properties.paddingProportions);
+    }
+    if (properties.spacingProportions != previous.spacingProportions) {
+        container.setSpacingProportions(properties.spacingProportions);
+    }
+    if (properties.layoutOrientation != previous.layoutOrientation) {
+        container.setLayoutOrientation(properties.layoutOrientation);
+    }
+    if (properties.alignment != previous.alignment) {
+        container.setAlignment(properties.alignment);
+    }
+
+    // Appearance properties. Removed colors are replaced by transparent ones
+    if (properties.background != previous.background) {
+        container.setBackground(properties.background.value_or(sf::Color::Transparent));
+    }
+    if (properties.outlineColor != previous.outlineColor or properties.outlineThickness != previous.outlineThickness) {
+        container.setOutline(properties.outlineColor.value_or(sf::Color::Transparent), properties.outlineThickness);
+    }
+    if (properties.isVisible != previous.isVisible) {
+        container.setVisible(properties.isVisible);
+    }
+    if (properties.isEnabled != previous.isEnabled) {
+        container.setEnabled(properties.isEnabled);
+    }
+
+    // The node outlives the callback, since the container is removed together with the node
+    if (properties.isClickable != previous.isClickable) {
+        if (properties.isClickable) {
+            container.setCallback([&node]() { node.wasClicked = true; });
+        } else {
+            container.setCallback(nullptr);
+        }
+    }
+
+    previous = properties;
+}
+
+// ___________________________________________________________________________
+UIComponent &ImmediateContext::declareComponent(const std::string &key, size_t stateHash,
+                                                const std::function<std::unique_ptr<UIComponent>()> &create,
+                                                const std::function<void(UIComponent &)> &update) {
+    if (openNodes_.empty()) {
+        throw std::runtime_error("Immediate mode declarations have to be made between begin and end.");
+    }
+
+    // Reuse the component declared with the same key. If the key belonged to a container, the container is replaced
+    Node* node = reuseChild(key);
+    if (node and !UIComponent::resolve(node->component)) {
+        Node& parent = *openNodes_.back();
+        removeChild(parent, --parent.declaredChildren);
+        node = nullptr;
+    }
+
+    if (!node) {
+        std::unique_ptr<UIComponent> component = create();
+        auto newNode = std::make_unique<Node>();
+        newNode->key = key;
+        newNode->component = component->getHandle();
+        newNode->stateHash = stateHash;
+        update(*component);
+        node = &insertChild(std::move(newNode), nullptr, std::move(component));
+    } else if (node->stateHash != stateHash) {
+        update(*UIComponent::resolve(node->component));
+        node->stateHash = stateHash;
+    }
+
+    return *UIComponent::resolve(node->component);
+}
+
+// ___________________________________________________________________________
+void ImmediateContext::removeChild(Node &parent, size_t index) {
+    Node& child = *parent.children[index];
+
+    // Elements removed by other means are only dropped from the state
+    if (Container* parentContainer = Container::resolve(parent.container)) {
+        if (Container::resolve(child.container)) {
+            parentContainer->removeContainer(child.container);
+        } else if (UIComponent::resolve(child.component)) {
+            parentContainer->removeUIComponent(child.component);
+        }
+    }
+
+    parent.children.erase(parent.children.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+// ___________________________________________________________________________
+void ImmediateContext::removeUndeclaredChildren(Node &node) {
+    // Remove from the back, so that the remaining children don't have to be shifted
+    while (node.children.size() > node.declaredChildren) {
+        removeChild(node, node.children.size() - 1);
+    }
+}
@@ -0,0 +1,120 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_IMMEDIATECONTEXT_H
+#define SWIFTIFYSFML_V0_1_IMMEDIATECONTEXT_H
+
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "Container.h"
+
+/*
+ * ImmediateProperties struct. Properties of a container declared in immediate mode. Compared with the properties of
+ * the previous frame, so that only the changed ones are set on the container.
+ */
+struct ImmediateProperties {
+    sf::Vector2f sizeProportions = sf::Vector2f(1, 1);
+    sf::Vector2f paddingProportions = sf::Vector2f(0, 0);
+    sf::Vector2f spacingProportions = sf::Vector2f(0, 0);
+    LayoutOrientation layoutOrientation = LayoutOrientation::None;
+    Alignment alignment = Alignment::Center;
+    std::optional<sf::Color> background;
+    std::optional<sf::Color> outlineColor;
+    float outlineThickness = 0;
+    bool isVisible = true;
+    bool isEnabled = true;
+
+    // Register a click callback, so that the declaration reports clicks
+    bool isClickable = false;
+};
+
+/*
+ * ImmediateContext class. Immediate-mode interface on top of a container. The user code declares the whole content
+ * every frame between begin and end, and the context reconciles the declarations with the retained tree:
+ * - Elements are identified by their key within their parent. Declaring the same keys in the same order reuses all
+ * elements and costs a key comparison and a property comparison per element
+ * - Only changed properties are set, so unchanged elements aren't invalidated
+ * - Reordered keys move the existing elements, new keys create elements, and elements that haven't been declared in
+ * a frame are removed at the end of their parent's declaration
+ *
+ * The context owns all elements of the root container. Elements added to it by other means are not supported.
+ */
+class ImmediateContext {
+public:
+    // Constructor and destructor
+    explicit ImmediateContext(Container& root);
+    ~ImmediateContext() = default;
+
+    // Start and finish the declarations of a frame
+    void begin();
+    void end();
+
+    // Declare a container and nest the following declarations in it until endContainer is called. Returns true if
+    // the container is clickable and has been clicked since its previous declaration
+    bool beginContainer(const std::string& key, const ImmediateProperties& properties = ImmediateProperties());
+    void endContainer();
+
+    // Declare a container without nested elements
+    bool container(const std::string& key, const ImmediateProperties& properties = ImmediateProperties());
+
+    // Declare a UI component. It's created with the factory on its first declaration. The update function is only
+    // called if the state hash differs from the previous declaration, e.g., a hash of the displayed text
+    template<typename T>
+    T& component(const std::string& key, size_t stateHash, const std::function<std::unique_ptr<T>()>& create,
+                 const std::function<void(T&)>& update) {
+        UIComponent& component = declareComponent(
+                key, stateHash, [&create]() -> std::unique_ptr<UIComponent> { return create(); },
+                [&update](UIComponent& component) { update(static_cast<T&>(component)); });
+        return static_cast<T&>(component);
+    }
+
+private:
+    // Retained state of a declared element. The children are kept in the same order as the elements of the container
+    struct Node {
+        std::string key;
+        ContainerHandle container;
+        UIComponentHandle component;
+        ImmediateProperties properties;
+        size_t stateHash = 0;
+        bool wasClicked = false;
+
+        // Children and the number of children declared in the current frame
+        std::vector<std::unique_ptr<Node>> children;
+        size_t declaredChildren = 0;
+    };
+
+    // Find the child of the current parent with the key and move it to the next declared position. Returns nullptr
+    // if the key hasn't been declared in the previous frame
+    Node* reuseChild(const std::string& key);
+
+    // Insert a new node with its element at the next declared position of the current parent
+    Node& insertChild(std::unique_ptr<Node> node, std::unique_ptr<Container> container,
+                      std::unique_ptr<UIComponent> component);
+
+    // Set the properties that differ from the previously declared ones
+    static void applyProperties(Container& container, Node& node, const ImmediateProperties& properties);
+
+    // Type-independent part of the component declaration
+    UIComponent& declareComponent(const std::string& key, size_t stateHash,
+                                  const std::function<std::unique_ptr<UIComponent>()>& create,
+                                  const std::function<void(UIComponent&)>& update);
+
+    // Remove a child node together with its element
+    static void removeChild(Node& parent, size_t index);
+
+    // Remove the children of a node that haven't been declared in the current frame
+    static void removeUndeclaredChildren(Node& node);
+
+    // Root of the retained state, referring to the root container
+    Node root_;
+
+    // Nodes whose declarations are currently open. The last one is the parent of the next declaration
+    std::vector<Node*> openNodes_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_IMMEDIATECONTEXT_H
@@ -0,0 +1,112 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "InputQueue.h"
+
+#include <algorithm>
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Coalesced events replace the queued event of their burst, but keep its position and timestamp, so that the
+ * latency is measured from the oldest input
+ * - Scroll deltas are accumulated, so no scrolling distance gets lost
+ * - All other events end the bursts, so that no event is dispatched before one received earlier that it depends on.
+ * Resizes and pointer events depend on each other as well, since the pointer position refers to the layout
+ */
+// ___________________________________________________________________________
+void InputQueue::push(const sf::Event &event) {
+    statistics_.receivedEvents++;
+
+    // Replace the event of the current burst of the same kind, or start a new burst
+    auto coalesce = [this, &event](std::optional<size_t>& burst) -> sf::Event& {
+        if (burst) {
+            events_[*burst].event = event;
+        } else {
+            burst = events_.size();
+            events_.push_back({event, clock_.getElapsedTime()});
+        }
+        return events_[*burst].event;
+    };
+
+    switch (event.type) {
+        case sf::Event::Resized:
+            mouseMoveEvent_.reset();
+            verticalScrollEvent_.reset();
+            horizontalScrollEvent_.reset();
+            coalesce(resizeEvent_);
+            break;
+
+        case sf::Event::MouseMoved:
+            resizeEvent_.reset();
+            coalesce(mouseMoveEvent_);
+            break;
+
+        case sf::Event::MouseWheelScrolled: {
+            resizeEvent_.reset();
+            auto& burst = event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel ? verticalScrollEvent_
+                                                                                   : horizontalScrollEvent_;
+            float delta = burst ? events_[*burst].event.mouseWheelScroll.delta : 0;
+            coalesce(burst).mouseWheelScroll.delta += delta;
+            break;
+        }
+
+        default:
+            endBursts();
+            events_.push_back({event, clock_.getElapsedTime()});
+            break;
+    }
+}
+
+// ___________________________________________________________________________
+void InputQueue::dispatch(const std::function<void(sf::Event&)> &handler) {
+    // Events pushed by the handler are dispatched with the next frame
+    std::vector<TimedEvent> events;
+    events.swap(events_);
+    endBursts();
+
+    for (auto& timedEvent: events) {
+        dispatchEvent(timedEvent, handler);
+    }
+
+    // Keep the allocation for the next frame
+    if (events_.empty()) {
+        events.clear();
+        events_.swap(events);
+    }
+}
+
+// ___________________________________________________________________________
+bool InputQueue::isEmpty() const {
+    return events_.empty();
+}
+
+// ___________________________________________________________________________
+const InputStatistics &InputQueue::getStatistics() const {
+    return statistics_;
+}
+
+// ___________________________________________________________________________
+void InputQueue::resetStatistics() {
+    statistics_ = InputStatistics();
+}
+
+// ___________________________________________________________________________
+void InputQueue::endBursts() {
+    resizeEvent_.reset();
+    mouseMoveEvent_.reset();
+    verticalScrollEvent_.reset();
+    horizontalScrollEvent_.reset();
+}
+
+// ___________________________________________________________________________
+void InputQueue::dispatchEvent(InputQueue::TimedEvent &timedEvent, const std::function<void(sf::Event &)> &handler) {
+    // Update the counters
+    sf::Time latency = clock_.getElapsedTime() - timedEvent.timestamp;
+    statistics_.dispatchedEvents++;
+    statistics_.totalLatency += latency;
+    statistics_.maxLatency = std::max(statistics_.maxLatency, latency);
+
+    handler(timedEvent.event);
+}
@@ -0,0 +1,80 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_INPUTQUEUE_H
+#define SWIFTIFYSFML_V0_1_INPUTQUEUE_H
+
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <optional>
+#include <vector>
+
+/*
+ * InputStatistics struct. Counters of the input queue. The latency is the time between receiving an event and
+ * dispatching it. Coalesced events count with the time of the oldest event they replace.
+ */
+struct InputStatistics {
+    size_t receivedEvents = 0;
+    size_t dispatchedEvents = 0;
+    sf::Time totalLatency;
+    sf::Time maxLatency;
+};
+
+/*
+ * InputQueue class. Collects the events of a frame and dispatches them once per frame, in the order they were
+ * received. Mouse motion, scroll and resize events are coalesced, so that a burst of them only causes a single
+ * dispatch. Coalescing never moves an event across one it depends on: any other event, e.g., a click, a key or the
+ * mouse leaving the window, ends the bursts before it, so it sees the layout and the pointer position of the events
+ * received before it. A resize also ends the motion and scroll bursts, and is ended by them.
+ */
+class InputQueue {
+public:
+    // Constructor and destructor
+    InputQueue() = default;
+    ~InputQueue() = default;
+
+    // Add an event to the queue and timestamp it
+    void push(const sf::Event& event);
+
+    // Dispatch the collected events to the handler and clear the queue
+    void dispatch(const std::function<void(sf::Event&)>& handler);
+
+    // Returns true if no event is waiting to be dispatched
+    [[nodiscard]] bool isEmpty() const;
+
+    // Get and reset the counters
+    [[nodiscard]] const InputStatistics& getStatistics() const;
+    void resetStatistics();
+
+private:
+    // Event with the time it has been received
+    struct TimedEvent {
+        sf::Event event;
+        sf::Time timestamp;
+    };
+
+    // Pass a single event to the handler and update the counters
+    void dispatchEvent(TimedEvent& timedEvent, const std::function<void(sf::Event&)>& handler);
+
+    // End the bursts of coalesced events, so that the following events of their kinds are queued separately
+    void endBursts();
+
+    // Events in the order they were received
+    std::vector<TimedEvent> events_;
+
+    // Indices of the events of the current bursts in the queue. Only the latest position and size are kept and the
+    // scroll deltas are summed up per wheel
+    std::optional<size_t> resizeEvent_;
+    std::optional<size_t> mouseMoveEvent_;
+    std::optional<size_t> verticalScrollEvent_;
+    std::optional<size_t> horizontalScrollEvent_;
+
+    // Clock used for the timestamps
+    sf::Clock clock_;
+
+    // Counters
+    InputStatistics statistics_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_INPUTQUEUE_H
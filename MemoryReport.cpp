@@ -0,0 +1,135 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "MemoryReport.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// ___________________________________________________________________________
+size_t MemoryReport::getTotalBytes() const {
+    return containerBytes + uiComponentBytes + layoutBytes + renderBytes + cacheBytes + assetBytes;
+}
+
+// ___________________________________________________________________________
+MemoryReport &MemoryReport::operator+=(const MemoryReport &other) {
+    containerCount += other.containerCount;
+    containerBytes += other.containerBytes;
+    uiComponentCount += other.uiComponentCount;
+    uiComponentBytes += other.uiComponentBytes;
+    layoutBytes += other.layoutBytes;
+    renderBytes += other.renderBytes;
+    cacheBytes += other.cacheBytes;
+    assetBytes += other.assetBytes;
+
+    // The tracked heap is process-wide, so the latest value is kept instead of summing up
+    if (other.trackedHeapBytes) {
+        trackedHeapBytes = other.trackedHeapBytes;
+    }
+    return *this;
+}
+
+// ___________________________________________________________________________
+void MemoryReport::print(std::ostream &stream) const {
+    // Average bytes per node of a type
+    auto average = [](size_t bytes, size_t count) -> size_t { return count > 0 ? bytes / count : 0; };
+
+    stream << "Containers:    " << containerCount << " nodes, " << containerBytes << " bytes ("
+           << average(containerBytes, containerCount) << " per node)" << std::endl;
+    stream << "UI components: " << uiComponentCount << " nodes, " << uiComponentBytes << " bytes ("
+           << average(uiComponentBytes, uiComponentCount) << " per node)" << std::endl;
+    stream << "Layout:        " << layoutBytes << " bytes" << std::endl;
+    stream << "Render:        " << renderBytes << " bytes" << std::endl;
+    stream << "Caches:        " << cacheBytes << " bytes" << std::endl;
+    stream << "Assets:        " << assetBytes << " bytes" << std::endl;
+    stream << "Total:         " << getTotalBytes() << " bytes" << std::endl;
+    if (trackedHeapBytes) {
+        stream << "Tracked heap:  " << *trackedHeapBytes << " bytes" << std::endl;
+    }
+}
+
+// ___________________________________________________________________________
+size_t getHeapBytes(const std::string &string) {
+    // The capacity of an empty string is the inline buffer of the small string optimization
+    static const size_t inlineCapacity = std::string().capacity();
+    return string.capacity() > inlineCapacity ? string.capacity() + 1 : 0;
+}
+
+#ifdef SWIFTIFYSFML_TRACK_ALLOCATIONS
+
+// Counters of the replaced global allocation functions
+static std::atomic<size_t> trackedHeapBytes{0};
+static std::atomic<size_t> trackedAllocationCount{0};
+
+// Each allocation is prefixed with its size. The prefix keeps the alignment of the returned memory
+static constexpr size_t allocationPrefix = alignof(std::max_align_t);
+
+// ___________________________________________________________________________
+static void* allocateTracked(size_t size) {
+    void* memory = std::malloc(size + allocationPrefix);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+
+    *static_cast<size_t*>(memory) = size;
+    trackedHeapBytes.fetch_add(size, std::memory_order_relaxed);
+    trackedAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<char*>(memory) + allocationPrefix;
+}
+
+// ___________________________________________________________________________
+static void freeTracked(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+
+    void* memory = static_cast<char*>(pointer) - allocationPrefix;
+    trackedHeapBytes.fetch_sub(*static_cast<size_t*>(memory), std::memory_order_relaxed);
+    trackedAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+    std::free(memory);
+}
+
+// Replacements of the global allocation functions. The nothrow and sized variants forward to these by default.
+// Over-aligned allocations aren't counted
+void* operator new(size_t size) { return allocateTracked(size); }
+void* operator new[](size_t size) { return allocateTracked(size); }
+void operator delete(void* pointer) noexcept { freeTracked(pointer); }
+void operator delete[](void* pointer) noexcept { freeTracked(pointer); }
+void operator delete(void* pointer, size_t) noexcept { freeTracked(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { freeTracked(pointer); }
+
+// ___________________________________________________________________________
+bool isAllocationTrackingEnabled() {
+    return true;
+}
+
+// ___________________________________________________________________________
+size_t getTrackedHeapBytes() {
+    return trackedHeapBytes.load(std::memory_order_relaxed);
+}
+
+// ___________________________________________________________________________
+size_t getTrackedAllocationCount() {
+    return trackedAllocationCount.load(std::memory_order_relaxed);
+}
+
+#else
+
+// ___________________________________________________________________________
+bool isAllocationTrackingEnabled() {
+    return false;
+}
+
+// ___________________________________________________________________________
+size_t getTrackedHeapBytes() {
+    return 0;
+}
+
+// ___________________________________________________________________________
+size_t getTrackedAllocationCount() {
+    return 0;
+}
+
+#endif
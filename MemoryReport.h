@@ -0,0 +1,59 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_MEMORYREPORT_H
+#define SWIFTIFYSFML_V0_1_MEMORYREPORT_H
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+
+/*
+ * MemoryReport struct. Memory footprint of a tree of containers and UI components, split by node type and by
+ * subsystem. The values are the object sizes plus the capacities of their heap buffers, so they are estimates: the
+ * targets of std::function callbacks and the allocator overhead aren't visible. Building with
+ * SWIFTIFYSFML_TRACK_ALLOCATIONS defined counts the actual heap usage of the process in addition.
+ */
+struct MemoryReport {
+    // Number of nodes per type and the bytes of the node objects including their names and callback tables
+    size_t containerCount = 0;
+    size_t containerBytes = 0;
+    size_t uiComponentCount = 0;
+    size_t uiComponentBytes = 0;
+
+    // Bytes per subsystem:
+    // - Layout: element vectors, grid state and expressions
+    // - Render: background shapes, styles and animation states
+    // - Caches: cached layers, including the texture memory on the graphics card
+    // - Assets: fonts, textures and other resources held by UI components
+    size_t layoutBytes = 0;
+    size_t renderBytes = 0;
+    size_t cacheBytes = 0;
+    size_t assetBytes = 0;
+
+    // Heap bytes allocated by the whole process when the report has been created. Only set with allocation tracking
+    std::optional<size_t> trackedHeapBytes;
+
+    // Sum of the node and subsystem bytes
+    [[nodiscard]] size_t getTotalBytes() const;
+
+    // Add the counts and bytes of another report, e.g., to sum up several screens
+    MemoryReport& operator+=(const MemoryReport& other);
+
+    // Print the report in a human-readable form
+    void print(std::ostream& stream) const;
+};
+
+// Heap bytes used by a string. Short strings are stored inline and don't use any
+[[nodiscard]] size_t getHeapBytes(const std::string& string);
+
+// Returns true if heap allocations are counted, i.e., if SWIFTIFYSFML_TRACK_ALLOCATIONS has been defined
+[[nodiscard]] bool isAllocationTrackingEnabled();
+
+// Heap bytes and number of allocations currently held through operator new. Both are 0 without allocation tracking
+[[nodiscard]] size_t getTrackedHeapBytes();
+[[nodiscard]] size_t getTrackedAllocationCount();
+
+#endif //SWIFTIFYSFML_V0_1_MEMORYREPORT_H
@@ -0,0 +1,166 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "PieceTable.h"
+
+#include <algorithm>
+
+// ___________________________________________________________________________
+PieceTable::PieceTable(std::string text) : original_(std::move(text)), length_(original_.size()) {
+    if (length_ > 0) {
+        pieces_.push_back({false, 0, length_});
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Split the piece at the offset, so that the text can be inserted between two pieces
+ * - If the piece before ends where the added buffer ends, it has been the last insertion, so it is extended instead
+ * of adding a piece. This keeps the number of pieces low while typing
+ */
+// ___________________________________________________________________________
+void PieceTable::insert(size_t offset, const std::string &text) {
+    if (text.empty()) {
+        return;
+    }
+    offset = std::min(offset, length_);
+
+    size_t index = splitAt(offset);
+    if (index > 0 and pieces_[index - 1].isAdded and
+        pieces_[index - 1].start + pieces_[index - 1].length == added_.size()) {
+        Piece& previous = pieces_[index - 1];
+        cachedPiece_ = index - 1;
+        cachedStart_ = offset - previous.length;
+        previous.length += text.size();
+    } else {
+        pieces_.insert(pieces_.begin() + static_cast<std::ptrdiff_t>(index), {true, added_.size(), text.size()});
+        cachedPiece_ = index;
+        cachedStart_ = offset;
+    }
+
+    added_ += text;
+    length_ += text.size();
+}
+
+// ___________________________________________________________________________
+void PieceTable::erase(size_t offset, size_t length) {
+    offset = std::min(offset, length_);
+    length = std::min(length, length_ - offset);
+    if (length == 0) {
+        return;
+    }
+
+    // Split at both ends of the range and drop the pieces in between
+    size_t first = splitAt(offset);
+    size_t last = splitAt(offset + length);
+    pieces_.erase(pieces_.begin() + static_cast<std::ptrdiff_t>(first),
+                  pieces_.begin() + static_cast<std::ptrdiff_t>(last));
+    length_ -= length;
+
+    cachedPiece_ = first;
+    cachedStart_ = offset;
+}
+
+// ___________________________________________________________________________
+char PieceTable::at(size_t offset) const {
+    size_t pieceStart;
+    const Piece& piece = pieces_[findPiece(offset, pieceStart)];
+    return getBuffer(piece)[piece.start + offset - pieceStart];
+}
+
+// ___________________________________________________________________________
+void PieceTable::copyText(size_t offset, size_t length, std::string &text) const {
+    offset = std::min(offset, length_);
+    length = std::min(length, length_ - offset);
+    if (length == 0) {
+        return;
+    }
+
+    size_t pieceStart;
+    size_t index = findPiece(offset, pieceStart);
+    size_t pieceOffset = offset - pieceStart;
+    while (length > 0) {
+        const Piece& piece = pieces_[index];
+        size_t count = std::min(length, piece.length - pieceOffset);
+        text.append(getBuffer(piece), piece.start + pieceOffset, count);
+        length -= count;
+        pieceOffset = 0;
+        index++;
+    }
+}
+
+// ___________________________________________________________________________
+std::string PieceTable::getText() const {
+    std::string text;
+    text.reserve(length_);
+    for (auto& piece: pieces_) {
+        text.append(getBuffer(piece), piece.start, piece.length);
+    }
+    return text;
+}
+
+// ___________________________________________________________________________
+size_t PieceTable::getLength() const {
+    return length_;
+}
+
+// ___________________________________________________________________________
+size_t PieceTable::getPieceCount() const {
+    return pieces_.size();
+}
+
+// ___________________________________________________________________________
+size_t PieceTable::getMemoryUsage() const {
+    return original_.capacity() + added_.capacity() + pieces_.capacity() * sizeof(Piece);
+}
+
+// ___________________________________________________________________________
+size_t PieceTable::findPiece(size_t offset, size_t &pieceStart) const {
+    // Walk from the piece found last toward the offset
+    size_t index = std::min(cachedPiece_, pieces_.size());
+    size_t start = index == cachedPiece_ ? cachedStart_ : length_;
+    while (index > 0 and start > offset) {
+        index--;
+        start -= pieces_[index].length;
+    }
+    while (index < pieces_.size() and start + pieces_[index].length <= offset) {
+        start += pieces_[index].length;
+        index++;
+    }
+
+    cachedPiece_ = index;
+    cachedStart_ = start;
+    pieceStart = start;
+    return index;
+}
+
+// ___________________________________________________________________________
+size_t PieceTable::splitAt(size_t offset) {
+    if (offset >= length_) {
+        return pieces_.size();
+    }
+
+    size_t pieceStart;
+    size_t index = findPiece(offset, pieceStart);
+    if (pieceStart == offset) {
+        return index;
+    }
+
+    // Keep the part before the offset and insert the rest after it
+    Piece& piece = pieces_[index];
+    size_t leftLength = offset - pieceStart;
+    Piece right{piece.isAdded, piece.start + leftLength, piece.length - leftLength};
+    piece.length = leftLength;
+    pieces_.insert(pieces_.begin() + static_cast<std::ptrdiff_t>(index) + 1, right);
+
+    cachedPiece_ = index + 1;
+    cachedStart_ = offset;
+    return index + 1;
+}
+
+// ___________________________________________________________________________
+const std::string &PieceTable::getBuffer(const Piece &piece) const {
+    return piece.isAdded ? added_ : original_;
+}
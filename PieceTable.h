@@ -0,0 +1,78 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_PIECETABLE_H
+#define SWIFTIFYSFML_V0_1_PIECETABLE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+ * PieceTable class. Editable text stored as a sequence of pieces, each referring to a range of either the original
+ * text or an append-only buffer of added text. Edits only split and insert pieces, the text itself is never moved,
+ * so their cost depends on the number of pieces and not on the length of the text. Consecutive insertions at the
+ * same position extend the last piece instead of adding new ones. Offsets are in bytes. Lookups start at the piece
+ * found last, so edits and reads close to each other don't scan the whole table.
+ */
+class PieceTable {
+public:
+    // Constructor and destructor
+    PieceTable() = default;
+    explicit PieceTable(std::string text);
+    ~PieceTable() = default;
+
+    // Insert text at an offset, or erase a range. Ranges are clamped to the text
+    void insert(size_t offset, const std::string& text);
+    void erase(size_t offset, size_t length);
+
+    // Get the character at an offset, which has to be less than the length
+    [[nodiscard]] char at(size_t offset) const;
+
+    // Append a range of the text to a string, e.g., to reuse the string's memory. Ranges are clamped to the text
+    void copyText(size_t offset, size_t length, std::string& text) const;
+
+    // Get the whole text
+    [[nodiscard]] std::string getText() const;
+
+    // Get the length of the text in bytes and the number of pieces
+    [[nodiscard]] size_t getLength() const;
+    [[nodiscard]] size_t getPieceCount() const;
+
+    // Get the memory used by the buffers and the pieces in bytes
+    [[nodiscard]] size_t getMemoryUsage() const;
+
+private:
+    // Range of the original or the added buffer
+    struct Piece {
+        bool isAdded = false;
+        size_t start = 0;
+        size_t length = 0;
+    };
+
+    // Get the index of the piece containing the offset, which has to be less than the length, and set the start
+    // offset of that piece
+    size_t findPiece(size_t offset, size_t& pieceStart) const;
+
+    // Split the piece containing the offset, so that a piece starts at the offset. Returns the index of that piece,
+    // or the number of pieces if the offset is the length
+    size_t splitAt(size_t offset);
+
+    // Get the buffer a piece refers to
+    [[nodiscard]] const std::string& getBuffer(const Piece& piece) const;
+
+    // Original text and the text added since, which is only appended to
+    std::string original_;
+    std::string added_;
+
+    // Pieces in text order and the total length of the text
+    std::vector<Piece> pieces_;
+    size_t length_ = 0;
+
+    // Index and start offset of the piece found last. Kept valid across edits
+    mutable size_t cachedPiece_ = 0;
+    mutable size_t cachedStart_ = 0;
+};
+
+#endif //SWIFTIFYSFML_V0_1_PIECETABLE_H
@@ -0,0 +1,377 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "Plot.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// ___________________________________________________________________________
+Plot::Plot(std::string name, const sf::Vector2f &sizeProportions, double timeSpan)
+: UIComponent(std::move(name), sizeProportions), timeSpan_(timeSpan) {
+    if (!(timeSpan > 0) or !std::isfinite(timeSpan)) {
+        throw std::runtime_error("Plot time span has to be positive and finite.");
+    }
+}
+
+// ___________________________________________________________________________
+size_t Plot::addSeries(sf::Color color, Decimation decimation, size_t capacity) {
+    Series series;
+    series.color = color;
+    series.decimation = decimation;
+    series.times.resize(std::max<size_t>(capacity, 1));
+    series.values.resize(std::max<size_t>(capacity, 1));
+    series_.push_back(std::move(series));
+
+    requestRenderUpdate();
+    return series_.size() - 1;
+}
+
+// ___________________________________________________________________________
+void Plot::append(size_t series, double time, float value) {
+    append(series, &time, &value, 1);
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Store each sample in the ring buffer, overwriting the oldest one once it is full
+ * - Add it to the column aggregates, unless the plot hasn't got a size yet. The columns are built from the ring buffer
+ * once it has
+ * - Only the first append after a frame requests a render update, which keeps appending cheap
+ */
+// ___________________________________________________________________________
+void Plot::append(size_t series, const double *times, const float *values, size_t count) {
+    if (series >= series_.size()) {
+        throw std::runtime_error("Series index " + std::to_string(series) + " is out of range.");
+    }
+
+    Series& target = series_[series];
+    size_t capacity = target.times.size();
+    for (size_t index = 0; index < count; index++) {
+        double time = times[index];
+        if (target.sampleCount > 0) {
+            time = std::max(time, target.times[(target.sampleCount - 1) % capacity]);
+        }
+
+        size_t slot = target.sampleCount % capacity;
+        target.times[slot] = time;
+        target.values[slot] = values[index];
+        if (columnDuration_ > 0) {
+            addToColumns(target, target.sampleCount);
+        }
+        target.sampleCount++;
+    }
+
+    if (!needRenderUpdate_) {
+        requestRenderUpdate();
+    }
+}
+
+// ___________________________________________________________________________
+void Plot::setTimeSpan(double timeSpan) {
+    if (!(timeSpan > 0) or !std::isfinite(timeSpan)) {
+        std::cerr << "Plot time span has to be positive and finite. Keeping the previous time span." << std::endl;
+        return;
+    }
+
+    timeSpan_ = timeSpan;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void Plot::setColumnWidth(float columnWidth) {
+    if (columnWidth < 1) {
+        std::cerr << "Plot column width has to be at least one pixel. Keeping the previous width." << std::endl;
+        return;
+    }
+
+    columnWidth_ = columnWidth;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void Plot::setValueRange(float minimum, float maximum) {
+    minimumValue_ = minimum;
+    maximumValue_ = maximum;
+    isAutoRange_ = false;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void Plot::setAutoRange() {
+    isAutoRange_ = true;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+size_t Plot::getSeriesCount() const {
+    return series_.size();
+}
+
+// ___________________________________________________________________________
+size_t Plot::getSampleCount(size_t series) const {
+    return series_.at(series).sampleCount;
+}
+
+// ___________________________________________________________________________
+size_t Plot::getVertexCount(size_t series) const {
+    return series_.at(series).vertices.size();
+}
+
+// ___________________________________________________________________________
+void Plot::draw(sf::RenderTarget &target, sf::RenderStates states) {
+    if (!isVisible_) {
+        return;
+    }
+
+    for (auto& series: series_) {
+        if (!series.vertices.empty()) {
+            target.draw(series.vertices.data(), series.vertices.size(), sf::LineStrip, states);
+        }
+    }
+}
+
+// ___________________________________________________________________________
+bool Plot::handleEvent(const sf::Event &) {
+    return false;
+}
+
+// ___________________________________________________________________________
+void Plot::updateRenderInformation() {
+    size_ = sf::Vector2f(parentSize_.x * sizeProportions_.x, parentSize_.y * sizeProportions_.y);
+
+    // Aggregate the samples again if the columns changed, i.e., if the width or the time span changed
+    std::int64_t columnCount = std::max<std::int64_t>(1, static_cast<std::int64_t>(size_.x / columnWidth_));
+    double columnDuration = timeSpan_ / static_cast<double>(columnCount);
+    if (columnCount != columnCount_ or columnDuration != columnDuration_) {
+        columnCount_ = columnCount;
+        columnDuration_ = columnDuration;
+        for (auto& series: series_) {
+            rebuildColumns(series);
+        }
+    }
+
+    buildVertices();
+    needRenderUpdate_ = false;
+}
+
+// ___________________________________________________________________________
+void Plot::collectMemoryUsage(MemoryReport &report) const {
+    UIComponent::collectMemoryUsage(report);
+    report.uiComponentBytes += sizeof(Plot) - sizeof(UIComponent);
+    report.layoutBytes += series_.capacity() * sizeof(Series);
+    for (auto& series: series_) {
+        report.assetBytes += series.times.capacity() * sizeof(double) + series.values.capacity() * sizeof(float);
+        report.layoutBytes += series.columns.size() * sizeof(Column);
+        report.renderBytes += series.vertices.capacity() * sizeof(sf::Vertex);
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Samples of the last column update its minimum, maximum and sums. The order of the minimum and the maximum is kept,
+ * so that the line strip visits them in time order
+ * - A sample of a later column starts a new one. The column before the previous one now has a complete next column,
+ * so its largest triangle sample is selected. Selections are never revised, which keeps the line stable while it
+ * scrolls
+ * - Columns that have scrolled out of view are dropped, except for one that the first visible selection starts from
+ */
+// ___________________________________________________________________________
+void Plot::addToColumns(Series &series, std::uint64_t sample) {
+    size_t slot = sample % series.times.size();
+    double time = series.times[slot];
+    float value = series.values[slot];
+    auto index = static_cast<std::int64_t>(std::floor(time / columnDuration_));
+
+    if (series.columns.empty() or series.columns.back().index != index) {
+        Column column;
+        column.index = index;
+        column.firstSample = sample;
+        column.minimum = value;
+        column.maximum = value;
+        series.columns.push_back(column);
+
+        if (series.decimation == Decimation::LargestTriangle and series.columns.size() >= 3) {
+            size_t selectedIndex = series.columns.size() - 3;
+            sf::Vector2<double> previous = getSelectedPoint(series, selectedIndex > 0 ? selectedIndex - 1 : 0);
+            Column& selected = series.columns[selectedIndex];
+            selected.isSelected = findLargestTriangle(series, selectedIndex, previous,
+                                                      getAverage(series.columns[selectedIndex + 1]),
+                                                      selected.selectedTime, selected.selectedValue);
+        }
+
+        while (series.columns.front().index < index - columnCount_) {
+            series.columns.pop_front();
+        }
+    }
+
+    Column& column = series.columns.back();
+    if (value < column.minimum) {
+        column.minimum = value;
+        column.isMinimumFirst = false;
+    } else if (value > column.maximum) {
+        column.maximum = value;
+        column.isMinimumFirst = true;
+    }
+    column.timeSum += time;
+    column.valueSum += value;
+    column.count++;
+}
+
+// ___________________________________________________________________________
+void Plot::rebuildColumns(Series &series) {
+    series.columns.clear();
+    if (columnDuration_ <= 0) {
+        return;
+    }
+
+    // Only the samples of the visible time span and the column before it are aggregated
+    std::uint64_t capacity = series.times.size();
+    std::uint64_t firstSample = series.sampleCount > capacity ? series.sampleCount - capacity : 0;
+    double startTime = getEndTime() - timeSpan_ - columnDuration_;
+    for (std::uint64_t sample = firstSample; sample < series.sampleCount; sample++) {
+        if (series.times[sample % capacity] >= startTime) {
+            addToColumns(series, sample);
+        }
+    }
+}
+
+// ___________________________________________________________________________
+bool Plot::findLargestTriangle(const Series &series, size_t column, sf::Vector2<double> previous,
+                               sf::Vector2<double> next, double &time, float &value) {
+    std::uint64_t capacity = series.times.size();
+    std::uint64_t oldestSample = series.sampleCount > capacity ? series.sampleCount - capacity : 0;
+    std::uint64_t begin = std::max(series.columns[column].firstSample, oldestSample);
+    std::uint64_t end = column + 1 < series.columns.size() ? series.columns[column + 1].firstSample
+                                                             : series.sampleCount;
+
+    // Twice the area of the triangle. Scaling the axes scales all areas alike, so the units don't matter
+    double largestArea = -1;
+    for (std::uint64_t sample = begin; sample < end; sample++) {
+        double sampleTime = series.times[sample % capacity];
+        double sampleValue = series.values[sample % capacity];
+        double area = std::abs((previous.x - next.x) * (sampleValue - previous.y) -
+                               (previous.x - sampleTime) * (next.y - previous.y));
+        if (area > largestArea) {
+            largestArea = area;
+            time = sampleTime;
+            value = static_cast<float>(sampleValue);
+        }
+    }
+    return largestArea >= 0;
+}
+
+// ___________________________________________________________________________
+sf::Vector2<double> Plot::getSelectedPoint(const Series &series, size_t column) {
+    const Column& selected = series.columns[column];
+    if (selected.isSelected) {
+        return {selected.selectedTime, selected.selectedValue};
+    }
+    return getAverage(selected);
+}
+
+// ___________________________________________________________________________
+sf::Vector2<double> Plot::getAverage(const Column &column) {
+    double count = static_cast<double>(std::max<size_t>(column.count, 1));
+    return {column.timeSum / count, column.valueSum / count};
+}
+
+// ___________________________________________________________________________
+double Plot::getEndTime() const {
+    double endTime = -std::numeric_limits<double>::infinity();
+    for (auto& series: series_) {
+        if (series.sampleCount > 0) {
+            endTime = std::max(endTime, series.times[(series.sampleCount - 1) % series.times.size()]);
+        }
+    }
+    return std::isfinite(endTime) ? endTime : 0;
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - The last column contains the latest sample of all series. The visible columns are the ones before it, up to the
+ * width of the plot
+ * - A fitted value range covers the minimum and maximum of the visible columns of all series
+ * - Min-max series get two points in the middle of each column. Largest triangle series get their selected sample
+ * at its time. The last two columns have no selection yet, so it is computed from the current samples, without
+ * storing it
+ */
+// ___________________________________________________________________________
+void Plot::buildVertices() {
+    // Without columns, there is nothing to draw
+    if (columnDuration_ <= 0) {
+        for (auto& series: series_) {
+            series.vertices.clear();
+        }
+        return;
+    }
+
+    std::int64_t endColumn = static_cast<std::int64_t>(std::floor(getEndTime() / columnDuration_));
+    std::int64_t firstColumn = endColumn - columnCount_ + 1;
+    double startTime = static_cast<double>(firstColumn) * columnDuration_;
+
+    if (isAutoRange_) {
+        float minimum = std::numeric_limits<float>::max();
+        float maximum = std::numeric_limits<float>::lowest();
+        for (auto& series: series_) {
+            for (auto& column: series.columns) {
+                if (column.index >= firstColumn) {
+                    minimum = std::min(minimum, column.minimum);
+                    maximum = std::max(maximum, column.maximum);
+                }
+            }
+        }
+        if (minimum <= maximum) {
+            minimumValue_ = minimum == maximum ? minimum - 0.5f : minimum;
+            maximumValue_ = minimum == maximum ? maximum + 0.5f : maximum;
+        }
+    }
+
+    float valueScale = maximumValue_ != minimumValue_ ? size_.y / (maximumValue_ - minimumValue_) : 0;
+    float bottom = position_.y + size_.y;
+    auto toY = [&](double value) { return bottom - static_cast<float>(value - minimumValue_) * valueScale; };
+
+    for (auto& series: series_) {
+        series.vertices.clear();
+        for (size_t index = 0; index < series.columns.size(); index++) {
+            const Column& column = series.columns[index];
+            if (column.index < firstColumn) {
+                continue;
+            }
+
+            if (series.decimation == Decimation::MinMax) {
+                float x = position_.x + (static_cast<float>(column.index - firstColumn) + 0.5f) * columnWidth_;
+                float first = column.isMinimumFirst ? column.minimum : column.maximum;
+                float second = column.isMinimumFirst ? column.maximum : column.minimum;
+                series.vertices.emplace_back(sf::Vector2f(x, toY(first)), series.color);
+                series.vertices.emplace_back(sf::Vector2f(x, toY(second)), series.color);
+                continue;
+            }
+
+            sf::Vector2<double> point = getAverage(column);
+            if (column.isSelected) {
+                point = {column.selectedTime, column.selectedValue};
+            } else if (index + 1 == series.columns.size()) {
+                size_t slot = (series.sampleCount - 1) % series.times.size();
+                point = {series.times[slot], series.values[slot]};
+            } else {
+                float value;
+                sf::Vector2<double> previous = getSelectedPoint(series, index > 0 ? index - 1 : 0);
+                if (findLargestTriangle(series, index, previous, getAverage(series.columns[index + 1]), point.x,
+                                        value)) {
+                    point.y = value;
+                }
+            }
+            float x = position_.x + static_cast<float>((point.x - startTime) / columnDuration_) * columnWidth_;
+            series.vertices.emplace_back(sf::Vector2f(x, toY(point.y)), series.color);
+        }
+    }
+}
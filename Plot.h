@@ -0,0 +1,126 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_PLOT_H
+#define SWIFTIFYSFML_V0_1_PLOT_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "UIComponent.h"
+
+/*
+ * Plot class. Line plot of sample streams, e.g., live telemetry. Each series keeps its latest samples in a ring
+ * buffer and aggregates them per column as they are appended, so an append only updates the column of the sample.
+ * The visible time span ends at the latest sample of all series and is split into columns, which are one pixel wide
+ * by default. Each frame, every series is drawn as a single line strip built from its column aggregates, so the cost
+ * of drawing depends on the width of the plot and not on the number of samples.
+ */
+class Plot : public UIComponent {
+public:
+    // Constructor and destructor. The time span is the visible duration, in the unit of the sample times. Throws if
+    // it isn't positive and finite
+    Plot(std::string name, const sf::Vector2f& sizeProportions, double timeSpan);
+    ~Plot() override = default;
+
+    // Add a series. Its latest samples are kept in a ring buffer of the capacity, which should hold at least the
+    // samples of a few pixel columns. Returns the index of the series
+    size_t addSeries(sf::Color color, Decimation decimation = Decimation::MinMax, size_t capacity = 1 << 16);
+
+    // Append samples to a series. Times have to be ascending, earlier times are moved to the latest time
+    void append(size_t series, double time, float value);
+    void append(size_t series, const double* times, const float* values, size_t count);
+
+    // Set the visible duration. Aggregates the samples in the ring buffers again for the new columns. Durations that
+    // aren't positive and finite are rejected
+    void setTimeSpan(double timeSpan);
+
+    // Set the width of a column in pixels. Wider columns aggregate more samples each, so the line strips get fewer
+    // vertices, e.g., to lower the resolution under load
+    void setColumnWidth(float columnWidth);
+
+    // Set a fixed value range, or fit the range to the visible samples of all series
+    void setValueRange(float minimum, float maximum);
+    void setAutoRange();
+
+    // Get the number of series, the number of samples appended to a series in total and the number of vertices of its
+    // line strip
+    [[nodiscard]] size_t getSeriesCount() const;
+    [[nodiscard]] size_t getSampleCount(size_t series) const;
+    [[nodiscard]] size_t getVertexCount(size_t series) const;
+
+    // UI-related functions
+    void draw(sf::RenderTarget& target, sf::RenderStates states) override;
+    bool handleEvent(const sf::Event& event) override;
+    void updateRenderInformation() override;
+    void collectMemoryUsage(MemoryReport& report) const override;
+
+private:
+    // Aggregate of the samples of a series in one pixel column. The largest triangle sample is selected once the
+    // column after the next one has started, since it depends on the average of the next column
+    struct Column {
+        std::int64_t index = 0;
+        std::uint64_t firstSample = 0;
+        float minimum = 0;
+        float maximum = 0;
+        bool isMinimumFirst = true;
+        double timeSum = 0;
+        double valueSum = 0;
+        size_t count = 0;
+        bool isSelected = false;
+        double selectedTime = 0;
+        float selectedValue = 0;
+    };
+
+    // Series with its ring buffer of samples. Sample n is stored at n modulo the capacity
+    struct Series {
+        sf::Color color;
+        Decimation decimation = Decimation::MinMax;
+        std::vector<double> times;
+        std::vector<float> values;
+        std::uint64_t sampleCount = 0;
+        std::deque<Column> columns;
+        std::vector<sf::Vertex> vertices;
+    };
+
+    // Add a stored sample to the columns of a series
+    void addToColumns(Series& series, std::uint64_t sample);
+
+    // Aggregate the samples in the ring buffer of a series again, e.g., after the columns changed
+    void rebuildColumns(Series& series);
+
+    // Select the sample of a column forming the largest triangle with the previous point and the next point. Samples
+    // that have left the ring buffer are skipped. Returns false if the column has none left
+    static bool findLargestTriangle(const Series& series, size_t column, sf::Vector2<double> previous,
+                                    sf::Vector2<double> next, double& time, float& value);
+
+    // Get the point of a column that the selection of the next column starts from
+    static sf::Vector2<double> getSelectedPoint(const Series& series, size_t column);
+
+    // Get the average of a column
+    static sf::Vector2<double> getAverage(const Column& column);
+
+    // Get the latest time of all series
+    [[nodiscard]] double getEndTime() const;
+
+    // Rebuild the line strips of all series from their columns
+    void buildVertices();
+
+    // Series of the plot
+    std::vector<Series> series_;
+
+    // Visible duration, and the width, duration and number of the columns. The duration is 0 until the plot has a size
+    double timeSpan_;
+    float columnWidth_ = 1;
+    double columnDuration_ = 0;
+    std::int64_t columnCount_ = 0;
+
+    // Value range mapped to the height of the plot, and a flag indicating if it is fitted to the visible samples
+    float minimumValue_ = 0;
+    float maximumValue_ = 1;
+    bool isAutoRange_ = true;
+};
+
+#endif //SWIFTIFYSFML_V0_1_PLOT_H
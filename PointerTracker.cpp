@@ -0,0 +1,205 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "PointerTracker.h"
+
+// ___________________________________________________________________________
+PointerTracker::PointerTracker(Container &root) : root_(root) {}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Mouse moves update the hovered chain
+ * - A left button press updates the hovered chain at the press position first, then presses all hovered elements.
+ * A release releases the pressed elements, wherever the cursor is, and updates the hovered chain afterward
+ * - Leaving the window leaves all hovered elements. Pressed elements stay pressed until the button is released
+ * - States are gained from the root down and lost from the topmost element up
+ */
+// ___________________________________________________________________________
+void PointerTracker::handleEvent(const sf::Event &event) {
+    switch (event.type) {
+        case sf::Event::MouseMoved:
+            updateHovered(sf::Vector2f(static_cast<float>(event.mouseMove.x), static_cast<float>(event.mouseMove.y)),
+                          event);
+            break;
+        case sf::Event::MouseButtonPressed:
+            if (event.mouseButton.button == sf::Mouse::Left) {
+                updateHovered(sf::Vector2f(static_cast<float>(event.mouseButton.x),
+                                           static_cast<float>(event.mouseButton.y)), event);
+                for (auto element = pressed_.rbegin(); element != pressed_.rend(); ++element) {
+                    setPressed(*element, false, event);
+                }
+                pressed_ = hovered_;
+                for (auto& element: pressed_) {
+                    setPressed(element, true, event);
+                }
+            }
+            break;
+        case sf::Event::MouseButtonReleased:
+            if (event.mouseButton.button == sf::Mouse::Left) {
+                for (auto element = pressed_.rbegin(); element != pressed_.rend(); ++element) {
+                    setPressed(*element, false, event);
+                }
+                pressed_.clear();
+                updateHovered(sf::Vector2f(static_cast<float>(event.mouseButton.x),
+                                           static_cast<float>(event.mouseButton.y)), event);
+            }
+            break;
+        case sf::Event::MouseLeft:
+            hasPosition_ = false;
+            for (auto element = hovered_.rbegin(); element != hovered_.rend(); ++element) {
+                setHovered(*element, false, event);
+            }
+            hovered_.clear();
+            break;
+        default:
+            break;
+    }
+}
+
+// ___________________________________________________________________________
+void PointerTracker::refresh() {
+    if (!hasPosition_) {
+        return;
+    }
+
+    sf::Event event{};
+    event.type = sf::Event::MouseMoved;
+    event.mouseMove.x = static_cast<int>(position_.x);
+    event.mouseMove.y = static_cast<int>(position_.y);
+    updateHovered(position_, event);
+}
+
+// ___________________________________________________________________________
+size_t PointerTracker::getHoveredCount() const {
+    return hovered_.size();
+}
+
+// ___________________________________________________________________________
+size_t PointerTracker::getPressedCount() const {
+    return pressed_.size();
+}
+
+// ___________________________________________________________________________
+// Returns true if the element is visible, enabled and contains the position.
+// ___________________________________________________________________________
+template<typename Element>
+static bool isHit(const Element& element, sf::Vector2f position) {
+    return element.isVisible() and element.isEnabled() and
+           sf::FloatRect(element.getPosition(), element.getSize()).contains(position);
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Descend from the root container into the element under the position, one element per level. Only the elements
+ * along the path are tested, not the whole tree
+ * - Later elements are drawn on top of earlier ones, so each container is searched from back to front
+ * - A UI component ends the chain
+ */
+// ___________________________________________________________________________
+void PointerTracker::hitTest(sf::Vector2f position, std::vector<ElementHandle> &chain) const {
+    chain.clear();
+
+    const Container* container = isHit(root_, position) ? &root_ : nullptr;
+    while (container) {
+        chain.emplace_back(container->getHandle());
+
+        const Container* nextContainer = nullptr;
+        for (size_t index = container->elements_.size(); index-- > 0;) {
+            auto& element = container->elements_[index];
+            if (auto* nested = std::get_if<std::unique_ptr<Container>>(&element)) {
+                if (isHit(**nested, position)) {
+                    nextContainer = nested->get();
+                    break;
+                }
+            } else if (auto& component = *std::get<std::unique_ptr<UIComponent>>(element); isHit(component, position)) {
+                chain.emplace_back(component.getHandle());
+                break;
+            }
+        }
+        container = nextContainer;
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Both chains start at the root container, so they share a common prefix. Only the elements after it changed
+ * - Leave the old elements after the prefix from the topmost up, then enter the new ones from the prefix down
+ * - Swap the chains, so that the old chain's memory is reused for the next hit test
+ */
+// ___________________________________________________________________________
+void PointerTracker::updateHovered(sf::Vector2f position, const sf::Event &event) {
+    position_ = position;
+    hasPosition_ = true;
+    hitTest(position, nextHovered_);
+
+    size_t commonLength = 0;
+    while (commonLength < hovered_.size() and commonLength < nextHovered_.size() and
+           hovered_[commonLength] == nextHovered_[commonLength]) {
+        commonLength++;
+    }
+
+    for (size_t index = hovered_.size(); index-- > commonLength;) {
+        setHovered(hovered_[index], false, event);
+    }
+    for (size_t index = commonLength; index < nextHovered_.size(); index++) {
+        setHovered(nextHovered_[index], true, event);
+    }
+
+    std::swap(hovered_, nextHovered_);
+}
+
+// ___________________________________________________________________________
+void PointerTracker::setHovered(const ElementHandle &element, bool hovered, const sf::Event &event) {
+    CallbackType type = hovered ? CallbackType::Enter : CallbackType::Leave;
+
+    if (auto* handle = std::get_if<ContainerHandle>(&element)) {
+        Container* container = Container::resolve(*handle);
+        if (!container or container->isHovered_ == hovered) {
+            return;
+        }
+
+        container->isHovered_ = hovered;
+        if (container->callbacks_ and (*container->callbacks_)[static_cast<size_t>(type)]) {
+            (*container->callbacks_)[static_cast<size_t>(type)](event);
+        }
+    } else {
+        UIComponent* component = UIComponent::resolve(std::get<UIComponentHandle>(element));
+        if (!component or component->isHovered_ == hovered) {
+            return;
+        }
+
+        component->isHovered_ = hovered;
+        component->onHoverChanged(hovered);
+        component->invokeCallback(type, event);
+    }
+}
+
+// ___________________________________________________________________________
+void PointerTracker::setPressed(const ElementHandle &element, bool pressed, const sf::Event &event) {
+    CallbackType type = pressed ? CallbackType::Press : CallbackType::Release;
+
+    if (auto* handle = std::get_if<ContainerHandle>(&element)) {
+        Container* container = Container::resolve(*handle);
+        if (!container or container->isPressed_ == pressed) {
+            return;
+        }
+
+        container->isPressed_ = pressed;
+        if (container->callbacks_ and (*container->callbacks_)[static_cast<size_t>(type)]) {
+            (*container->callbacks_)[static_cast<size_t>(type)](event);
+        }
+    } else {
+        UIComponent* component = UIComponent::resolve(std::get<UIComponentHandle>(element));
+        if (!component or component->isPressed_ == pressed) {
+            return;
+        }
+
+        component->isPressed_ = pressed;
+        component->onPressedChanged(pressed);
+        component->invokeCallback(type, event);
+    }
+}
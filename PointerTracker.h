@@ -0,0 +1,63 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_POINTERTRACKER_H
+#define SWIFTIFYSFML_V0_1_POINTERTRACKER_H
+
+#include <SFML/Graphics.hpp>
+#include <variant>
+#include <vector>
+#include "Container.h"
+
+/*
+ * PointerTracker class. Tracks the chain of elements under the cursor, from the root container down to the topmost
+ * element, and the chain of elements pressed with the left mouse button. On each mouse event, only the path under
+ * the cursor is hit-tested, and the new chain is compared with the previous one. Enter, leave, press and release
+ * notifications are only delivered to the elements whose state changed, so only these are redrawn. Elements are
+ * stored as handles, so removing an element while it is hovered or pressed is safe.
+ */
+class PointerTracker {
+public:
+    // Constructor and destructor. The root container has to outlive the tracker
+    explicit PointerTracker(Container& root);
+    ~PointerTracker() = default;
+
+    // Update the hovered and pressed elements from a mouse event. The event is still meant to be passed on to the tree
+    void handleEvent(const sf::Event& event);
+
+    // Hit-test the last cursor position again, e.g., after the layout under a resting cursor changed
+    void refresh();
+
+    // Get the number of hovered and pressed elements, including the root container
+    [[nodiscard]] size_t getHoveredCount() const;
+    [[nodiscard]] size_t getPressedCount() const;
+
+private:
+    // Handle to an element of either type
+    using ElementHandle = std::variant<ContainerHandle, UIComponentHandle>;
+
+    // Collect the visible and enabled elements under the position, from the root down to the topmost element
+    void hitTest(sf::Vector2f position, std::vector<ElementHandle>& chain) const;
+
+    // Hit-test the position and notify the elements that the cursor entered or left
+    void updateHovered(sf::Vector2f position, const sf::Event& event);
+
+    // Set the flags of an element and call its callbacks and hooks. Elements that don't exist anymore are skipped
+    static void setHovered(const ElementHandle& element, bool hovered, const sf::Event& event);
+    static void setPressed(const ElementHandle& element, bool pressed, const sf::Event& event);
+
+    // Root container of the tree
+    Container& root_;
+
+    // Hovered and pressed chains, ordered from the root container down. The next chain is kept to reuse its memory
+    std::vector<ElementHandle> hovered_;
+    std::vector<ElementHandle> pressed_;
+    std::vector<ElementHandle> nextHovered_;
+
+    // Last cursor position and a flag indicating if the cursor is inside the window
+    sf::Vector2f position_;
+    bool hasPosition_ = false;
+};
+
+#endif //SWIFTIFYSFML_V0_1_POINTERTRACKER_H
@@ -7,26 +7,73 @@
 #include <iostream>
 
 Screen::Screen(std::string name, sf::RenderWindow &window)
-: name_(std::move(name)), window_(window), rootContainer_("Root", sf::Vector2f(1, 1)) {
+: name_(std::move(name)), window_(window), rootContainer_("Root", sf::Vector2f(1, 1)), focusManager_(rootContainer_),
+  pointerTracker_(rootContainer_) {
     std::cout << "Screen name: " << name_ << std::endl;
     // Initialize the root container
     rootContainer_.setPosition(sf::Vector2f(0, 0));
     rootContainer_.setParentSize(static_cast<sf::Vector2f> (window.getSize()));
+
+    // Register the screen to get a stable handle
+    handle_ = getRegistry().insert(this);
+}
+
+Screen::~Screen() {
+    // Invalidate all handles to this screen
+    getRegistry().erase(handle_);
 }
 
 // Implementation of move constructor
 Screen::Screen(Screen&& other) noexcept
         : app_(std::move(other.app_)),
           name_(std::move(other.name_)),
+          handle_(other.handle_),
           window_(other.window_),
-          rootContainer_(std::move(other.rootContainer_)) {}
+          rootContainer_(std::move(other.rootContainer_)),
+          focusManager_(rootContainer_),
+          pointerTracker_(rootContainer_) {
+    // Let the handle refer to the new address
+    getRegistry().update(handle_, this);
+    other.handle_ = ScreenHandle();
+}
 
-void Screen::draw(sf::RenderWindow &window) {
-    rootContainer_.draw(window);
+Screen *Screen::resolve(ScreenHandle handle) {
+    return getRegistry().resolve(handle);
+}
+
+SlotMap<Screen> &Screen::getRegistry() {
+    // Constructed on first use, so it exists before any screen
+    static SlotMap<Screen> registry;
+    return registry;
+}
+
+void Screen::draw(sf::RenderTarget &target) {
+    rootContainer_.draw(target);
+}
+
+void Screen::prewarm() {
+    rootContainer_.updateLayout();
+}
+
+void Screen::prewarmGeometry() {
+    rootContainer_.updateGeometry();
 }
 
 void Screen::handleEvent(sf::Event &event) {
-    rootContainer_.handleEvent(event);
+    pointerTracker_.handleEvent(event);
+    if (!focusManager_.handleEvent(event)) {
+        rootContainer_.handleEvent(event);
+    }
+}
+
+MemoryReport Screen::getMemoryReport() const {
+    MemoryReport report;
+    rootContainer_.collectMemoryUsage(report);
+    report.layoutBytes += focusManager_.getMemoryUsage();
+    if (isAllocationTrackingEnabled()) {
+        report.trackedHeapBytes = getTrackedHeapBytes();
+    }
+    return report;
 }
 
 void Screen::setPaddingProportions(sf::Vector2f paddingProportions) {
@@ -53,27 +100,47 @@ void Screen::setLayoutOrientation(LayoutOrientation layoutOrientation) {
     rootContainer_.setLayoutOrientation(layoutOrientation);
 }
 
+void Screen::setGridTracks(std::vector<float> columnProportions, std::vector<float> rowProportions) {
+    rootContainer_.setGridTracks(std::move(columnProportions), std::move(rowProportions));
+}
+
 void Screen::setApplication(std::shared_ptr<Application> app) {
     // Move the shared application pointer to the screen class
     app_ = std::move(app);
 }
 
 void Screen::addContainer(std::unique_ptr<Container> container) {
-    // Add parent size information to the container
-    container->setParentSize(static_cast<sf::Vector2f> (window_.getSize()));
-
-    // Add the container
+    // The root container passes its size on to the container, unless a batch is open
     rootContainer_.addContainer(std::move(container));
 }
 
 void Screen::addUIComponent(std::unique_ptr<UIComponent> component) {
-    // Add parent size information to the UIComponent
-    component->setParentSize(static_cast<sf::Vector2f> (window_.getSize()));
-
-    // Add the UIComponent
+    // The root container passes its size on to the UIComponent, unless a batch is open
     rootContainer_.addUIComponent(std::move(component));
 }
 
+void Screen::addContainer(std::unique_ptr<Container> container, GridCell cell) {
+    // The root container assigns the cell size as parent size during its grid layout pass
+    rootContainer_.addContainer(std::move(container), cell);
+}
+
+void Screen::addUIComponent(std::unique_ptr<UIComponent> component, GridCell cell) {
+    // The root container assigns the cell size as parent size during its grid layout pass
+    rootContainer_.addUIComponent(std::move(component), cell);
+}
+
+void Screen::reserve(size_t elementCount) {
+    rootContainer_.reserve(elementCount);
+}
+
+void Screen::beginBatch() {
+    rootContainer_.beginBatch();
+}
+
+void Screen::commitBatch() {
+    rootContainer_.commitBatch();
+}
+
 void Screen::removeContainer(const std::string &containerName) {
     rootContainer_.removeContainer(containerName);
 }
@@ -86,4 +153,16 @@ const std::string &Screen::getName() {
     return name_;
 }
 
+ScreenHandle Screen::getHandle() const {
+    return handle_;
+}
+
+FocusManager &Screen::getFocusManager() {
+    return focusManager_;
+}
+
+PointerTracker &Screen::getPointerTracker() {
+    return pointerTracker_;
+}
+
 
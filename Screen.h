@@ -8,11 +8,17 @@
 #include <SFML/Graphics.hpp>
 #include "Enumerations.h"
 #include "Container.h"
+#include "FocusManager.h"
+#include "PointerTracker.h"
 // #include "Application.h"
 
 // Forward declaration of Application
 class Application;
 
+// Stable handle to a screen
+class Screen;
+using ScreenHandle = Handle<Screen>;
+
 /*
  * Abstract Screen class. Has essential virtual function definitions and can be extended to fit the specific needs
  * of a certain application screen. It should also have access to the main application via a shared pointer.
@@ -21,16 +27,34 @@ class Screen {
 public:
     // Constructor and destructor
     Screen(std::string name, sf::RenderWindow& window);
-    virtual ~Screen() = default;
+    virtual ~Screen();
 
-    // Move constructor
+    // Move constructor. The handle moves along with the screen
     Screen(Screen&& other) noexcept;
 
+    // Get the screen a handle refers to. Returns nullptr if it doesn't exist anymore
+    static Screen* resolve(ScreenHandle handle);
+
     // Draw the content of all child views to the screen by calling their draw functions
-    virtual void draw(sf::RenderWindow& window);
+    virtual void draw(sf::RenderTarget& target);
+
+    // Compute the pending layout of the whole screen without drawing it, including the render information of the UI
+    // components
+    virtual void prewarm();
+
+    // Compute the pending geometry of the containers only. UI components are skipped, since their render information
+    // can use assets shared with other screens, e.g., the glyphs of a font. Doesn't use the window or any shared
+    // asset, so it can run on a worker thread as long as the screen isn't modified meanwhile
+    virtual void prewarmGeometry();
 
+    // Update the hovered and pressed elements and route key events to the focused component, if there is one. All
+    // other events are passed through the tree
     virtual void handleEvent(sf::Event& event);
 
+    // Get the memory used by the screen's content. Subclasses holding assets, e.g., fonts or textures, add them to
+    // the report's asset bytes
+    [[nodiscard]] virtual MemoryReport getMemoryReport() const;
+
     // --- Setter functions ---
 
     // Set the padding proportions
@@ -49,6 +73,9 @@ public:
     // Set the layout
     void setLayoutOrientation(LayoutOrientation layoutOrientation);
 
+    // Set the tracks of the grid layout
+    void setGridTracks(std::vector<float> columnProportions, std::vector<float> rowProportions);
+
     // Set a shared pointer to the main application instance
     void setApplication(std::shared_ptr<Application> app);
 
@@ -56,6 +83,16 @@ public:
     void addContainer(std::unique_ptr<Container> container);
     void addUIComponent(std::unique_ptr<UIComponent> component);
 
+    // Add a container or UI component to a specific cell of the grid layout
+    void addContainer(std::unique_ptr<Container> container, GridCell cell);
+    void addUIComponent(std::unique_ptr<UIComponent> component, GridCell cell);
+
+    // Reserve space in the root container and batch the construction of the screen's content. Committing the batch
+    // measures and arranges the whole screen once
+    void reserve(size_t elementCount);
+    void beginBatch();
+    void commitBatch();
+
     // Remove a container or UIComponent by name
     void removeContainer(const std::string& containerName);
     void removeUIComponent(const std::string& componentName);
@@ -63,19 +100,36 @@ public:
     // --- Getter functions ---
 
     const std::string& getName();
+    [[nodiscard]] ScreenHandle getHandle() const;
+
+    // Get the focus manager and the pointer tracker of the screen's content
+    FocusManager& getFocusManager();
+    PointerTracker& getPointerTracker();
 
 protected:
     // Pointer to the main application handling the application interactions on the highest level
     std::shared_ptr<Application> app_;
 
+    // Registry of all screens, used to resolve handles
+    static SlotMap<Screen>& getRegistry();
+
     // Name of the container for access and error messages
     std::string name_;
 
+    // Stable handle to this screen. Registered in the constructor and removed in the destructor
+    ScreenHandle handle_;
+
     // Window to draw the screen content to
     sf::RenderWindow& window_;
 
     // Root container
     Container rootContainer_;
+
+    // Keyboard focus inside the root container
+    FocusManager focusManager_;
+
+    // Hovered and pressed elements inside the root container
+    PointerTracker pointerTracker_;
 };
 
 #endif //SWIFTIFYSFML_V0_1_SCREEN_H
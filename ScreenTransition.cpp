@@ -0,0 +1,162 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "ScreenTransition.h"
+
+#include <algorithm>
+#include <iostream>
+
+// ___________________________________________________________________________
+ScreenTransition::~ScreenTransition() {
+    // The worker thread accesses the next screen, so it has to finish first
+    if (prewarmTask_.valid()) {
+        prewarmTask_.wait();
+    }
+}
+
+// ___________________________________________________________________________
+void ScreenTransition::start(Screen &from, Screen &to, TransitionType type, sf::Time duration) {
+    from_ = &from;
+    to_ = &to;
+    type_ = type;
+    duration_ = duration;
+    elapsed_ = sf::Time::Zero;
+
+    // Compute the geometry of the next screen on a worker thread. It isn't drawn or updated anywhere else until the
+    // transition starts running
+    phase_ = Phase::Prewarming;
+    prewarmTask_ = std::async(std::launch::async, [&to]() { to.prewarmGeometry(); });
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Wait for the worker thread without blocking the main loop
+ * - Capture both screens once. The UI components of the next screen are updated first, on this thread. This is also
+ * the first draw of the next screen, which creates its layers, so the first regular frame after the transition costs
+ * as much as any other frame
+ * - Advance the progress until the duration has passed
+ */
+// ___________________________________________________________________________
+bool ScreenTransition::update(sf::Time elapsed, sf::Vector2u targetSize) {
+    switch (phase_) {
+        case Phase::Inactive:
+            return false;
+
+        case Phase::Prewarming:
+            if (prewarmTask_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return false;
+            }
+            prewarmTask_.get();
+            phase_ = Phase::Capturing;
+            // Fallthrough intentional, capture right away
+        case Phase::Capturing:
+            captureScreens(targetSize);
+            phase_ = Phase::Running;
+
+            // Transitions without an animation finish as soon as the next screen is prepared
+            if (type_ == TransitionType::None or duration_ <= sf::Time::Zero) {
+                phase_ = Phase::Inactive;
+                return true;
+            }
+            return false;
+
+        case Phase::Running:
+            elapsed_ += elapsed;
+            if (elapsed_ >= duration_) {
+                phase_ = Phase::Inactive;
+                return true;
+            }
+            return false;
+    }
+
+    return false;
+}
+
+// ___________________________________________________________________________
+void ScreenTransition::draw(sf::RenderTarget &target) {
+    // Keep showing the previous screen while the next one is being prepared
+    if (phase_ == Phase::Prewarming or phase_ == Phase::Capturing) {
+        from_->draw(target);
+        return;
+    }
+    if (phase_ != Phase::Running) {
+        return;
+    }
+
+    // Smoothed progress of the transition
+    float progress = std::min(1.f, elapsed_ / duration_);
+    progress = progress * progress * (3 - 2 * progress);
+
+    sf::Sprite fromSprite(fromTexture_.getTexture());
+    sf::Sprite toSprite(toTexture_.getTexture());
+    sf::Vector2f size(static_cast<sf::Vector2f>(toTexture_.getSize()));
+
+    // Direction in which both screens move
+    sf::Vector2f direction(0, 0);
+
+    switch (type_) {
+        case TransitionType::None:
+            break;
+        case TransitionType::CrossFade:
+            toSprite.setColor(sf::Color(255, 255, 255, static_cast<sf::Uint8>(255 * progress)));
+            break;
+        case TransitionType::SlideLeft:
+            direction = sf::Vector2f(-size.x, 0);
+            break;
+        case TransitionType::SlideRight:
+            direction = sf::Vector2f(size.x, 0);
+            break;
+        case TransitionType::SlideUp:
+            direction = sf::Vector2f(0, -size.y);
+            break;
+        case TransitionType::SlideDown:
+            direction = sf::Vector2f(0, size.y);
+            break;
+    }
+
+    // The previous screen moves out while the next one moves in from the opposite side
+    fromSprite.setPosition(direction * progress);
+    toSprite.setPosition(direction * (progress - 1));
+
+    target.draw(fromSprite);
+    target.draw(toSprite);
+}
+
+// ___________________________________________________________________________
+void ScreenTransition::waitForPrewarming() {
+    if (phase_ == Phase::Prewarming and prewarmTask_.valid()) {
+        prewarmTask_.wait();
+    }
+}
+
+// ___________________________________________________________________________
+bool ScreenTransition::isActive() const {
+    return phase_ != Phase::Inactive;
+}
+
+// ___________________________________________________________________________
+Screen *ScreenTransition::getTargetScreen() const {
+    return to_;
+}
+
+// ___________________________________________________________________________
+void ScreenTransition::captureScreens(sf::Vector2u targetSize) {
+    // Recreate the textures only if the size changed
+    if (fromTexture_.getSize() != targetSize) {
+        if (!fromTexture_.create(targetSize.x, targetSize.y) or !toTexture_.create(targetSize.x, targetSize.y)) {
+            std::cerr << "Couldn't create the screen transition textures." << std::endl;
+        }
+    }
+
+    fromTexture_.clear();
+    from_->draw(fromTexture_);
+    fromTexture_.display();
+
+    // The worker only computed the geometry of the containers
+    to_->prewarm();
+    toTexture_.clear();
+    to_->draw(toTexture_);
+    toTexture_.display();
+}
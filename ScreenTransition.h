@@ -0,0 +1,80 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_SCREENTRANSITION_H
+#define SWIFTIFYSFML_V0_1_SCREENTRANSITION_H
+
+#include <SFML/Graphics.hpp>
+#include <future>
+#include "Enumerations.h"
+#include "Screen.h"
+
+/*
+ * ScreenTransition class. Switches from one screen to another in three phases:
+ * - Prewarming: the geometry of the next screen's containers is computed on a worker thread while the current screen
+ * keeps running
+ * - Capturing: the render information of the UI components is computed on the main thread, since it can use assets
+ * shared with the current screen, e.g., fonts. Then both screens are rendered once into render textures
+ * - Running: the transition is drawn from the two textures
+ *
+ * The next screen must not be modified while it is being prewarmed. The application waits for the prewarming before
+ * applying the change set and resuming background tasks, which may modify any screen. Event callbacks of the
+ * current screen must not modify the next screen during a transition.
+ */
+class ScreenTransition {
+public:
+    // Constructor and destructor
+    ScreenTransition() = default;
+    ~ScreenTransition();
+
+    // Start a transition. Starts prewarming the next screen right away
+    void start(Screen& from, Screen& to, TransitionType type, sf::Time duration);
+
+    // Advance the transition. Returns true once the transition has finished and the next screen can be shown
+    bool update(sf::Time elapsed, sf::Vector2u targetSize);
+
+    // Draw the current state of the transition. Draws the previous screen while the next one is still prewarming
+    void draw(sf::RenderTarget& target);
+
+    // Block until the next screen has been prewarmed, so that it can be modified again. Returns right away if it isn't
+    // being prewarmed
+    void waitForPrewarming();
+
+    // Returns true while a transition is in progress
+    [[nodiscard]] bool isActive() const;
+
+    // Get the screen the transition leads to. Only valid while the transition is active
+    [[nodiscard]] Screen* getTargetScreen() const;
+
+private:
+    // Phases of a transition
+    enum class Phase {
+        Inactive,
+        Prewarming,
+        Capturing,
+        Running
+    };
+
+    // Render both screens into the textures. Recreates the textures if the size changed
+    void captureScreens(sf::Vector2u targetSize);
+
+    // Screens taking part in the transition. Not owned
+    Screen* from_ = nullptr;
+    Screen* to_ = nullptr;
+
+    // Transition parameters and progress
+    Phase phase_ = Phase::Inactive;
+    TransitionType type_ = TransitionType::None;
+    sf::Time duration_;
+    sf::Time elapsed_;
+
+    // Result of the worker thread prewarming the next screen
+    std::future<void> prewarmTask_;
+
+    // Cached renderings of both screens. Kept between transitions to avoid recreating them
+    sf::RenderTexture fromTexture_;
+    sf::RenderTexture toTexture_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_SCREENTRANSITION_H
@@ -0,0 +1,301 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "SessionLog.h"
+
+#include <algorithm>
+#include <iostream>
+
+// Identification of the log format. The version is increased whenever the record layout changes
+static constexpr std::uint32_t sessionLogMagic = 0x53464C47;
+static constexpr std::uint32_t sessionLogVersion = 2;
+
+// Kinds of records in the log
+enum class RecordType : std::uint8_t {
+    Event,
+    Frame
+};
+
+// ___________________________________________________________________________
+void ReplayReport::print(std::ostream &stream) const {
+    if (frames.empty()) {
+        stream << "Replay contained no frames." << std::endl;
+        return;
+    }
+
+    // Sum up the phases and find the slowest frame
+    FrameTiming total;
+    FrameTiming maximum;
+    size_t slowestFrame = 0;
+    sf::Time slowestFrameTime;
+
+    for (size_t index = 0; index < frames.size(); index++) {
+        const FrameTiming& frame = frames[index];
+        total.events += frame.events;
+        total.dispatch += frame.dispatch;
+        total.layout += frame.layout;
+        total.draw += frame.draw;
+        total.uploadedBytes += frame.uploadedBytes;
+        maximum.dispatch = std::max(maximum.dispatch, frame.dispatch);
+        maximum.layout = std::max(maximum.layout, frame.layout);
+        maximum.draw = std::max(maximum.draw, frame.draw);
+        maximum.uploadedBytes = std::max(maximum.uploadedBytes, frame.uploadedBytes);
+
+        sf::Time frameTime = frame.dispatch + frame.layout + frame.draw;
+        if (frameTime > slowestFrameTime) {
+            slowestFrameTime = frameTime;
+            slowestFrame = index;
+        }
+    }
+
+    auto count = static_cast<sf::Int64>(frames.size());
+    stream << "Replayed " << frames.size() << " frames with " << total.events << " events." << std::endl;
+    stream << "Dispatch: total " << total.dispatch.asMicroseconds() << " us, average "
+           << total.dispatch.asMicroseconds() / count << " us, max " << maximum.dispatch.asMicroseconds() << " us"
+           << std::endl;
+    stream << "Layout:   total " << total.layout.asMicroseconds() << " us, average "
+           << total.layout.asMicroseconds() / count << " us, max " << maximum.layout.asMicroseconds() << " us"
+           << std::endl;
+    stream << "Draw:     total " << total.draw.asMicroseconds() << " us, average "
+           << total.draw.asMicroseconds() / count << " us, max " << maximum.draw.asMicroseconds() << " us"
+           << std::endl;
+    stream << "Uploads:  total " << total.uploadedBytes << " bytes, average "
+           << total.uploadedBytes / frames.size() << " bytes, max " << maximum.uploadedBytes << " bytes" << std::endl;
+    stream << "Slowest frame: " << slowestFrame << " with " << slowestFrameTime.asMicroseconds() << " us"
+           << std::endl;
+}
+
+// ___________________________________________________________________________
+bool SessionRecorder::start(const std::string &path, sf::Vector2u windowSize) {
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_) {
+        std::cerr << "Couldn't open session log '" << path << "' for recording." << std::endl;
+        return false;
+    }
+
+    write(sessionLogMagic);
+    write(sessionLogVersion);
+    write(windowSize.x);
+    write(windowSize.y);
+    clock_.restart();
+    return true;
+}
+
+// ___________________________________________________________________________
+void SessionRecorder::stop() {
+    file_.close();
+}
+
+// ___________________________________________________________________________
+bool SessionRecorder::isRecording() const {
+    return file_.is_open();
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Skip the events that aren't used by the UI, so that the log doesn't contain partial records. Closing and focus
+ * events are skipped as well: replaying them would act on the live window, e.g., close it
+ * - Write the record type, the timestamp and the event type, followed by only the fields of the event type
+ */
+// ___________________________________________________________________________
+void SessionRecorder::recordEvent(const sf::Event &event) {
+    switch (event.type) {
+        case sf::Event::Closed:
+        case sf::Event::LostFocus:
+        case sf::Event::GainedFocus:
+        case sf::Event::JoystickButtonPressed:
+        case sf::Event::JoystickButtonReleased:
+        case sf::Event::JoystickMoved:
+        case sf::Event::JoystickConnected:
+        case sf::Event::JoystickDisconnected:
+        case sf::Event::TouchBegan:
+        case sf::Event::TouchMoved:
+        case sf::Event::TouchEnded:
+        case sf::Event::SensorChanged:
+            return;
+        default:
+            break;
+    }
+
+    write(RecordType::Event);
+    write(static_cast<std::int64_t>(clock_.getElapsedTime().asMicroseconds()));
+    write(static_cast<std::uint8_t>(event.type));
+
+    switch (event.type) {
+        case sf::Event::Resized:
+            write(event.size);
+            break;
+        case sf::Event::TextEntered:
+            write(event.text.unicode);
+            break;
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased: {
+            // Pack the modifier keys into a single byte
+            auto modifiers = static_cast<std::uint8_t>(event.key.alt | event.key.control << 1 |
+                                                       event.key.shift << 2 | event.key.system << 3);
+            write(static_cast<std::int32_t>(event.key.code));
+            write(modifiers);
+            break;
+        }
+        case sf::Event::MouseWheelScrolled:
+            write(static_cast<std::uint8_t>(event.mouseWheelScroll.wheel));
+            write(event.mouseWheelScroll.delta);
+            write(static_cast<std::int32_t>(event.mouseWheelScroll.x));
+            write(static_cast<std::int32_t>(event.mouseWheelScroll.y));
+            break;
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            write(static_cast<std::uint8_t>(event.mouseButton.button));
+            write(static_cast<std::int32_t>(event.mouseButton.x));
+            write(static_cast<std::int32_t>(event.mouseButton.y));
+            break;
+        case sf::Event::MouseMoved:
+            write(static_cast<std::int32_t>(event.mouseMove.x));
+            write(static_cast<std::int32_t>(event.mouseMove.y));
+            break;
+        default:
+            // Mouse enter and leave events have no fields
+            break;
+    }
+}
+
+// ___________________________________________________________________________
+void SessionRecorder::recordFrame(sf::Time elapsed) {
+    write(RecordType::Frame);
+    write(static_cast<std::int64_t>(elapsed.asMicroseconds()));
+}
+
+// ___________________________________________________________________________
+template<typename T>
+void SessionRecorder::write(const T &value) {
+    file_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// ___________________________________________________________________________
+bool SessionReader::open(const std::string &path) {
+    file_.open(path, std::ios::binary);
+    if (!file_) {
+        std::cerr << "Couldn't open session log '" << path << "' for replaying." << std::endl;
+        return false;
+    }
+
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    if (!read(magic) or !read(version) or magic != sessionLogMagic or version != sessionLogVersion or
+        !read(windowSize_.x) or !read(windowSize_.y)) {
+        std::cerr << "'" << path << "' isn't a session log of a supported version." << std::endl;
+        file_.close();
+        return false;
+    }
+    return true;
+}
+
+// ___________________________________________________________________________
+bool SessionReader::readFrame(std::vector<sf::Event> &events, sf::Time &elapsed) {
+    events.clear();
+
+    // Collect events until the frame record closing them
+    RecordType type;
+    while (read(type)) {
+        if (type == RecordType::Frame) {
+            std::int64_t microseconds = 0;
+            if (!read(microseconds)) {
+                break;
+            }
+            elapsed = sf::microseconds(microseconds);
+            return true;
+        }
+
+        sf::Event event{};
+        if (type != RecordType::Event or !readEvent(event)) {
+            std::cerr << "Session log is corrupt. Stopped reading." << std::endl;
+            return false;
+        }
+        events.push_back(event);
+    }
+
+    // Events without a closing frame record are dropped, e.g., if the application has been killed
+    return false;
+}
+
+// ___________________________________________________________________________
+sf::Vector2u SessionReader::getWindowSize() const {
+    return windowSize_;
+}
+
+// ___________________________________________________________________________
+template<typename T>
+bool SessionReader::read(T &value) {
+    return static_cast<bool>(file_.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+// ___________________________________________________________________________
+bool SessionReader::readEvent(sf::Event &event) {
+    // The timestamp isn't needed for replaying at maximum speed
+    std::int64_t timestamp = 0;
+    std::uint8_t eventType = 0;
+    if (!read(timestamp) or !read(eventType) or eventType >= sf::Event::Count) {
+        return false;
+    }
+    event.type = static_cast<sf::Event::EventType>(eventType);
+
+    switch (event.type) {
+        case sf::Event::Resized:
+            return read(event.size);
+        case sf::Event::TextEntered:
+            return read(event.text.unicode);
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased: {
+            std::int32_t code = 0;
+            std::uint8_t modifiers = 0;
+            if (!read(code) or !read(modifiers)) {
+                return false;
+            }
+            event.key.code = static_cast<sf::Keyboard::Key>(code);
+            event.key.alt = modifiers & 1;
+            event.key.control = modifiers & 2;
+            event.key.shift = modifiers & 4;
+            event.key.system = modifiers & 8;
+            return true;
+        }
+        case sf::Event::MouseWheelScrolled: {
+            std::uint8_t wheel = 0;
+            std::int32_t x = 0;
+            std::int32_t y = 0;
+            if (!read(wheel) or !read(event.mouseWheelScroll.delta) or !read(x) or !read(y)) {
+                return false;
+            }
+            event.mouseWheelScroll.wheel = static_cast<sf::Mouse::Wheel>(wheel);
+            event.mouseWheelScroll.x = x;
+            event.mouseWheelScroll.y = y;
+            return true;
+        }
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased: {
+            std::uint8_t button = 0;
+            std::int32_t x = 0;
+            std::int32_t y = 0;
+            if (!read(button) or !read(x) or !read(y)) {
+                return false;
+            }
+            event.mouseButton.button = static_cast<sf::Mouse::Button>(button);
+            event.mouseButton.x = x;
+            event.mouseButton.y = y;
+            return true;
+        }
+        case sf::Event::MouseMoved: {
+            std::int32_t x = 0;
+            std::int32_t y = 0;
+            if (!read(x) or !read(y)) {
+                return false;
+            }
+            event.mouseMove.x = x;
+            event.mouseMove.y = y;
+            return true;
+        }
+        default:
+            return true;
+    }
+}
@@ -0,0 +1,113 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_SESSIONLOG_H
+#define SWIFTIFYSFML_V0_1_SESSIONLOG_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*
+ * FrameTiming struct. Time spent in the phases of a single replayed frame, the number of events fed into it and the
+ * vertex bytes uploaded by the static batches while drawing it.
+ */
+struct FrameTiming {
+    size_t events = 0;
+    sf::Time dispatch;
+    sf::Time layout;
+    sf::Time draw;
+    size_t uploadedBytes = 0;
+};
+
+/*
+ * ReplayReport struct. Timings of all frames of a replayed session, in order.
+ */
+struct ReplayReport {
+    std::vector<FrameTiming> frames;
+
+    // Print the total, average and maximum time of each phase and the slowest frame
+    void print(std::ostream& stream) const;
+};
+
+/*
+ * SessionRecorder class. Writes the input of a session to a binary log. The log starts with a header containing the
+ * size of the recorded window, followed by event records, each with its timestamp relative to the start of the
+ * recording, and frame records closing a frame with the time that has been used to advance the animations.
+ *
+ * Only the input is stored, not the changes to the tree. Changes made by callbacks and by the bindings they trigger
+ * are reproduced by replaying the same events on the same initial screens, since both run in a fixed order.
+ * Continuations of background tasks aren't: they resume when their work happens to finish, so sessions starting
+ * background tasks don't replay deterministically.
+ *
+ * Events are stored in a compact form per event type, in native byte order. Closing and focus events are window
+ * management rather than input and aren't recorded, nor are joystick, touch and sensor events.
+ */
+class SessionRecorder {
+public:
+    // Constructor and destructor. The destructor closes the log
+    SessionRecorder() = default;
+    ~SessionRecorder() = default;
+
+    // Open a log file and write its header with the size of the recorded window. Returns false if the file couldn't
+    // be opened
+    bool start(const std::string& path, sf::Vector2u windowSize);
+
+    // Close the log file
+    void stop();
+
+    // Returns true while a log file is open
+    [[nodiscard]] bool isRecording() const;
+
+    // Append an event or the end of a frame to the log
+    void recordEvent(const sf::Event& event);
+    void recordFrame(sf::Time elapsed);
+
+private:
+    // Write a value in native byte order
+    template<typename T>
+    void write(const T& value);
+
+    std::ofstream file_;
+
+    // Clock measuring the timestamps of the events
+    sf::Clock clock_;
+};
+
+/*
+ * SessionReader class. Reads a log written by the SessionRecorder frame by frame.
+ */
+class SessionReader {
+public:
+    // Constructor and destructor
+    SessionReader() = default;
+    ~SessionReader() = default;
+
+    // Open a log file and check its header. Returns false if the file couldn't be opened or isn't a session log
+    bool open(const std::string& path);
+
+    // Read the events and the elapsed time of the next frame. Returns false at the end of the log or if it is corrupt
+    bool readFrame(std::vector<sf::Event>& events, sf::Time& elapsed);
+
+    // Get the size of the recorded window
+    [[nodiscard]] sf::Vector2u getWindowSize() const;
+
+private:
+    // Read a value in native byte order. Returns false at the end of the file
+    template<typename T>
+    bool read(T& value);
+
+    // Read the payload of an event of the given type
+    bool readEvent(sf::Event& event);
+
+    std::ifstream file_;
+
+    // Size of the recorded window, read from the header
+    sf::Vector2u windowSize_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_SESSIONLOG_H
@@ -0,0 +1,218 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "ShapeGeometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+// The texture coordinates of shader shapes are the position in corner space plus the feather and the ring width as
+// integer levels. Corner space is normalized by the corner radius: 0 where a corner's arc starts and 1 on the edge.
+// Corner coordinates stay within [-4, 4), so the levels are spaced 8 apart and can be separated again by rounding.
+static constexpr float levelSpacing = 8;
+static constexpr float levelsPerRadius = 1024;
+
+// Fragment shader of the shapes. Decodes the texture coordinates, computes the signed distance to the rounded
+// rectangle in corner space and turns it into coverage, antialiased over a pixel unless the edge is feathered
+static const char* const shapeShaderSource = R"(
+void main() {
+    vec2 levels = floor((gl_TexCoord[0].xy + 4.0) / 8.0);
+    vec2 corner = gl_TexCoord[0].xy - 8.0 * levels;
+    float feather = levels.x / 1024.0;
+    float ringWidth = levels.y / 1024.0;
+
+    float distance = length(max(corner, 0.0)) + min(max(corner.x, corner.y), 0.0) - 1.0;
+    if (ringWidth > 0.0) {
+        distance = max(distance, -distance - ringWidth);
+    }
+
+    float width = max(feather > 0.0 ? feather : fwidth(distance), 0.0001);
+    float coverage = 1.0 - smoothstep(-0.5 * width, 0.5 * width, distance);
+    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * coverage);
+}
+)";
+
+// ___________________________________________________________________________
+void appendRectangle(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rectangle, sf::Color color) {
+    sf::Vector2f topLeft(rectangle.left, rectangle.top);
+    sf::Vector2f topRight(rectangle.left + rectangle.width, rectangle.top);
+    sf::Vector2f bottomLeft(rectangle.left, rectangle.top + rectangle.height);
+    sf::Vector2f bottomRight(rectangle.left + rectangle.width, rectangle.top + rectangle.height);
+
+    vertices.insert(vertices.end(), {sf::Vertex(topLeft, color), sf::Vertex(topRight, color),
+                                     sf::Vertex(bottomLeft, color), sf::Vertex(bottomLeft, color),
+                                     sf::Vertex(topRight, color), sf::Vertex(bottomRight, color)});
+}
+
+// ___________________________________________________________________________
+// Shrinks the rectangle by the amount on each side. Stops at zero size, centered on the rectangle.
+// ___________________________________________________________________________
+static sf::FloatRect insetRectangle(const sf::FloatRect& rectangle, float amount) {
+    float insetX = std::min(amount, rectangle.width / 2);
+    float insetY = std::min(amount, rectangle.height / 2);
+    return {rectangle.left + insetX, rectangle.top + insetY,
+            rectangle.width - 2 * insetX, rectangle.height - 2 * insetY};
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Split the shape into a 3x3 grid of quads: the corner quads hold the arcs, the edge quads the straight edges and
+ * the center quad the inside. The outer quads extend past the edge by the margin, so that the antialiased or
+ * feathered edge isn't cut off
+ * - Along an axis, the corner coordinate grows from 0 where the arc starts to 1 on the edge and beyond. Edge and
+ * center quads are inside along the axes they don't cross, so their coordinate is a constant -1 there
+ * - Rings don't cover the center quad, which is skipped
+ */
+// ___________________________________________________________________________
+static void appendShaderShape(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rectangle, float radius,
+                              sf::Color color, float ringWidth, float feather, float margin) {
+    sf::Vector2f levels(levelSpacing * std::round(feather / radius * levelsPerRadius),
+                        levelSpacing * std::round(ringWidth / radius * levelsPerRadius));
+    float outside = (radius + margin) / radius;
+
+    // Quad edges and the corner coordinates on them per axis. The middle quads use the constant instead
+    float right = rectangle.left + rectangle.width;
+    float bottom = rectangle.top + rectangle.height;
+    float edgesX[4] = {rectangle.left - margin, rectangle.left + radius, right - radius, right + margin};
+    float edgesY[4] = {rectangle.top - margin, rectangle.top + radius, bottom - radius, bottom + margin};
+    float corners[4] = {outside, 0, 0, outside};
+
+    for (size_t row = 0; row < 3; row++) {
+        for (size_t column = 0; column < 3; column++) {
+            if (row == 1 and column == 1 and ringWidth > 0) {
+                continue;
+            }
+
+            float cornerLeft = column == 1 ? -1 : corners[column];
+            float cornerRight = column == 1 ? -1 : corners[column + 1];
+            float cornerTop = row == 1 ? -1 : corners[row];
+            float cornerBottom = row == 1 ? -1 : corners[row + 1];
+
+            sf::Vertex topLeft(sf::Vector2f(edgesX[column], edgesY[row]), color,
+                               sf::Vector2f(cornerLeft, cornerTop) + levels);
+            sf::Vertex topRight(sf::Vector2f(edgesX[column + 1], edgesY[row]), color,
+                                sf::Vector2f(cornerRight, cornerTop) + levels);
+            sf::Vertex bottomLeft(sf::Vector2f(edgesX[column], edgesY[row + 1]), color,
+                                  sf::Vector2f(cornerLeft, cornerBottom) + levels);
+            sf::Vertex bottomRight(sf::Vector2f(edgesX[column + 1], edgesY[row + 1]), color,
+                                   sf::Vector2f(cornerRight, cornerBottom) + levels);
+
+            vertices.insert(vertices.end(), {topLeft, topRight, bottomLeft, bottomLeft, topRight, bottomRight});
+        }
+    }
+}
+
+// ___________________________________________________________________________
+// Appends the outline of a rounded rectangle clockwise, starting at the top-left corner, with a fixed number of
+// segments per corner. Shapes with the same number of segments have the same number of points.
+// ___________________________________________________________________________
+static void appendPerimeter(std::vector<sf::Vector2f>& points, const sf::FloatRect& rectangle, float radius,
+                            int segments) {
+    radius = std::clamp(radius, 0.f, std::min(rectangle.width, rectangle.height) / 2);
+    float right = rectangle.left + rectangle.width;
+    float bottom = rectangle.top + rectangle.height;
+
+    // Arc centers and start angles of the corners, in clockwise order
+    sf::Vector2f centers[4] = {{rectangle.left + radius, rectangle.top + radius},
+                               {right - radius, rectangle.top + radius},
+                               {right - radius, bottom - radius},
+                               {rectangle.left + radius, bottom - radius}};
+    const float pi = 3.14159265f;
+    float startAngles[4] = {pi, 1.5f * pi, 0, 0.5f * pi};
+
+    for (size_t corner = 0; corner < 4; corner++) {
+        for (int segment = 0; segment <= segments; segment++) {
+            float angle = startAngles[corner] + (segments > 0 ? 0.5f * pi * segment / segments : 0);
+            points.emplace_back(centers[corner] + radius * sf::Vector2f(std::cos(angle), std::sin(angle)));
+        }
+    }
+}
+
+// ___________________________________________________________________________
+// Appends triangles between two perimeters with the same number of points.
+// ___________________________________________________________________________
+static void appendRing(std::vector<sf::Vertex>& vertices, const std::vector<sf::Vector2f>& outer, sf::Color outerColor,
+                       const std::vector<sf::Vector2f>& inner, sf::Color innerColor) {
+    for (size_t index = 0; index < outer.size(); index++) {
+        size_t next = (index + 1) % outer.size();
+        vertices.insert(vertices.end(), {sf::Vertex(outer[index], outerColor), sf::Vertex(outer[next], outerColor),
+                                         sf::Vertex(inner[index], innerColor), sf::Vertex(inner[index], innerColor),
+                                         sf::Vertex(outer[next], outerColor), sf::Vertex(inner[next], innerColor)});
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - The number of segments per corner grows with the outer radius, so that the arcs stay smooth
+ * - Fills are fans around the center. Rings connect the outer perimeter with the perimeter inset by the ring width
+ * - Feathered shapes are an opaque fill inset by half the feather, surrounded by a ring fading out to the perimeter
+ * grown by half the feather. The fade is linear instead of smooth, which is hardly visible on shadows
+ */
+// ___________________________________________________________________________
+static void appendTessellatedShape(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rectangle, float radius,
+                                   sf::Color color, float ringWidth, float feather) {
+    sf::FloatRect outer = feather > 0 ? insetRectangle(rectangle, -feather / 2) : rectangle;
+    float outerRadius = feather > 0 ? radius + feather / 2 : radius;
+    int segments = outerRadius < 1 ? 0 : std::clamp(static_cast<int>(std::ceil(outerRadius / 2)), 2, 16);
+
+    std::vector<sf::Vector2f> outerPoints;
+    appendPerimeter(outerPoints, outer, outerRadius, segments);
+
+    sf::Color transparentColor(color.r, color.g, color.b, 0);
+    if (ringWidth > 0 or feather > 0) {
+        float inset = feather > 0 ? feather : ringWidth;
+        std::vector<sf::Vector2f> innerPoints;
+        appendPerimeter(innerPoints, insetRectangle(outer, inset), std::max(0.f, outerRadius - inset), segments);
+        appendRing(vertices, outerPoints, feather > 0 ? transparentColor : color, innerPoints, color);
+
+        if (ringWidth > 0) {
+            return;
+        }
+        outerPoints = std::move(innerPoints);
+    }
+
+    // Fan around the center of the remaining fill
+    sf::Vector2f center(rectangle.left + rectangle.width / 2, rectangle.top + rectangle.height / 2);
+    for (size_t index = 0; index < outerPoints.size(); index++) {
+        size_t next = (index + 1) % outerPoints.size();
+        vertices.insert(vertices.end(), {sf::Vertex(center, color), sf::Vertex(outerPoints[index], color),
+                                         sf::Vertex(outerPoints[next], color)});
+    }
+}
+
+// ___________________________________________________________________________
+void appendRoundedRectangle(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rectangle, float radius,
+                            sf::Color color, float ringWidth, float feather, bool useShader) {
+    radius = std::clamp(radius, 0.f, std::min(rectangle.width, rectangle.height) / 2);
+
+    // Shader shapes extend past the edge by half the feather and a pixel for antialiasing. The corner coordinates
+    // only stay within their range if the margin is small compared to the radius
+    float margin = feather / 2 + 1;
+    if (useShader and margin < 3 * radius) {
+        appendShaderShape(vertices, rectangle, radius, color, std::min(ringWidth, radius), feather, margin);
+    } else {
+        appendTessellatedShape(vertices, rectangle, radius, color, ringWidth, feather);
+    }
+}
+
+// ___________________________________________________________________________
+const sf::Shader* getShapeShader() {
+    static const std::unique_ptr<sf::Shader> shader = []() -> std::unique_ptr<sf::Shader> {
+        if (!sf::Shader::isAvailable()) {
+            return nullptr;
+        }
+
+        auto loadedShader = std::make_unique<sf::Shader>();
+        if (!loadedShader->loadFromMemory(shapeShaderSource, sf::Shader::Fragment)) {
+            std::cerr << "Couldn't load the shape shader. Rounded shapes are tessellated instead." << std::endl;
+            return nullptr;
+        }
+        return loadedShader;
+    }();
+    return shader.get();
+}
@@ -0,0 +1,34 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_SHAPEGEOMETRY_H
+#define SWIFTIFYSFML_V0_1_SHAPEGEOMETRY_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/*
+ * Triangle geometry of backgrounds, borders and shadows. Rounded rectangles are drawn with a signed distance shader
+ * if shaders are available: each shape is a few quads, and the texture coordinates of their vertices carry the
+ * position relative to the rounded corners together with the shape's parameters. Shapes of any parameters can
+ * therefore be mixed in a single draw call, e.g., in a static batch. Without shaders, rounded rectangles are
+ * tessellated instead. Vertices with default texture coordinates are drawn fully covered by the shader, so plain
+ * geometry can be drawn with it as well.
+ */
+
+// Append two triangles covering the rectangle
+void appendRectangle(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rectangle, sf::Color color);
+
+// Append a rectangle with rounded corners. A ring width above 0 only covers a ring of that width along the edge, e.g.,
+// for borders. A feather above 0 fades the edge out over that width, centered on the edge, e.g., for shadows. The
+// radius is limited to half the rectangle's size. Encodes the shape for the shape shader if useShader is set,
+// otherwise tessellates it
+void appendRoundedRectangle(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rectangle, float radius,
+                            sf::Color color, float ringWidth, float feather, bool useShader);
+
+// Get the shader for drawing the appended vertices. Loaded on first use. Returns nullptr if shaders aren't available,
+// in which case the shapes have to be tessellated
+const sf::Shader* getShapeShader();
+
+#endif //SWIFTIFYSFML_V0_1_SHAPEGEOMETRY_H
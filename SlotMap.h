@@ -0,0 +1,104 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_SLOTMAP_H
+#define SWIFTIFYSFML_V0_1_SLOTMAP_H
+
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+/*
+ * Handle struct. Stable reference to an object registered in a SlotMap. Consists of the slot index and the slot's
+ * generation at registration time. Once the object is removed, the generation of the slot changes and the handle
+ * resolves to nullptr, even if the slot is reused. Handles are plain values and can be copied to callbacks and
+ * worker threads.
+ */
+template<typename T>
+struct Handle {
+    std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t generation = 0;
+
+    friend bool operator==(const Handle& lhs, const Handle& rhs) {
+        return lhs.index == rhs.index and lhs.generation == rhs.generation;
+    }
+
+    friend bool operator!=(const Handle& lhs, const Handle& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+/*
+ * SlotMap class. Maps handles to objects in O(1). Doesn't own the objects, they register themselves on construction
+ * and remove themselves on destruction. Free slots are reused. All functions lock a mutex, so handles can be
+ * resolved from worker threads. Using the resolved object is still up to the caller's synchronization.
+ */
+template<typename T>
+class SlotMap {
+public:
+    // Register an object and get a handle to it
+    Handle<T> insert(T* object) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Reuse a free slot if possible
+        std::uint32_t index;
+        if (!freeIndices_.empty()) {
+            index = freeIndices_.back();
+            freeIndices_.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+
+        slots_[index].object = object;
+        return {index, slots_[index].generation};
+    }
+
+    // Let a handle point to a new address, e.g., after the object has been moved
+    void update(Handle<T> handle, T* object) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (isValid(handle)) {
+            slots_[handle.index].object = object;
+        }
+    }
+
+    // Remove an object. All handles to it become invalid
+    void erase(Handle<T> handle) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (isValid(handle)) {
+            slots_[handle.index].object = nullptr;
+            slots_[handle.index].generation++;
+            freeIndices_.push_back(handle.index);
+        }
+    }
+
+    // Get the object a handle refers to. Returns nullptr if the object has been removed
+    [[nodiscard]] T* resolve(Handle<T> handle) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        return isValid(handle) ? slots_[handle.index].object : nullptr;
+    }
+
+private:
+    // Slot storing the address and the current generation
+    struct Slot {
+        T* object = nullptr;
+        std::uint32_t generation = 0;
+    };
+
+    // Check if the handle refers to an occupied slot of the same generation. Expects the mutex to be locked
+    [[nodiscard]] bool isValid(Handle<T> handle) const {
+        return handle.index < slots_.size() and slots_[handle.index].generation == handle.generation and
+               slots_[handle.index].object;
+    }
+
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> freeIndices_;
+    mutable std::mutex mutex_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_SLOTMAP_H
@@ -0,0 +1,149 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "Style.h"
+#include "Container.h"
+
+#include <algorithm>
+
+// ___________________________________________________________________________
+Style::Style(const Style &other) : backgroundColor_(other.backgroundColor_),
+                                   outlineColor_(other.outlineColor_),
+                                   outlineThickness_(other.outlineThickness_),
+                                   cornerRadius_(other.cornerRadius_),
+                                   shadow_(other.shadow_),
+                                   paddingProportions_(other.paddingProportions_),
+                                   spacingProportions_(other.spacingProportions_) {}
+
+// ___________________________________________________________________________
+void Style::setBackground(sf::Color color) {
+    backgroundColor_ = color;
+    updateUsers(false);
+}
+
+// ___________________________________________________________________________
+void Style::setOutline(sf::Color color, float thickness) {
+    outlineColor_ = color;
+    outlineThickness_ = thickness;
+    updateUsers(false);
+}
+
+// ___________________________________________________________________________
+void Style::setCornerRadius(float cornerRadius) {
+    cornerRadius_ = cornerRadius;
+    updateUsers(false);
+}
+
+// ___________________________________________________________________________
+void Style::setShadow(Shadow shadow) {
+    shadow_ = shadow;
+    updateUsers(false);
+}
+
+// ___________________________________________________________________________
+void Style::setPaddingProportions(sf::Vector2f paddingProportions) {
+    paddingProportions_ = paddingProportions;
+    updateUsers(true);
+}
+
+// ___________________________________________________________________________
+void Style::setSpacingProportions(sf::Vector2f spacingProportions) {
+    spacingProportions_ = spacingProportions;
+    updateUsers(true);
+}
+
+// ___________________________________________________________________________
+void Style::assign(const Style &other) {
+    // Padding and spacing are the only values affecting the layout
+    bool affectsGeometry = paddingProportions_ != other.paddingProportions_ or
+                           spacingProportions_ != other.spacingProportions_;
+
+    backgroundColor_ = other.backgroundColor_;
+    outlineColor_ = other.outlineColor_;
+    outlineThickness_ = other.outlineThickness_;
+    cornerRadius_ = other.cornerRadius_;
+    shadow_ = other.shadow_;
+    paddingProportions_ = other.paddingProportions_;
+    spacingProportions_ = other.spacingProportions_;
+
+    updateUsers(affectsGeometry);
+}
+
+// ___________________________________________________________________________
+const std::optional<sf::Color> &Style::getBackground() const {
+    return backgroundColor_;
+}
+
+// ___________________________________________________________________________
+const std::optional<sf::Color> &Style::getOutlineColor() const {
+    return outlineColor_;
+}
+
+// ___________________________________________________________________________
+float Style::getOutlineThickness() const {
+    return outlineThickness_;
+}
+
+// ___________________________________________________________________________
+const std::optional<float> &Style::getCornerRadius() const {
+    return cornerRadius_;
+}
+
+// ___________________________________________________________________________
+const std::optional<Shadow> &Style::getShadow() const {
+    return shadow_;
+}
+
+// ___________________________________________________________________________
+const std::optional<sf::Vector2f> &Style::getPaddingProportions() const {
+    return paddingProportions_;
+}
+
+// ___________________________________________________________________________
+const std::optional<sf::Vector2f> &Style::getSpacingProportions() const {
+    return spacingProportions_;
+}
+
+// ___________________________________________________________________________
+void Style::addUser(Handle<Container> container) {
+    // Destroyed containers don't unregister themselves. Drop them before the vector would grow, so that their
+    // handles don't pile up if containers come and go without the style ever changing
+    if (users_.size() == users_.capacity()) {
+        users_.erase(std::remove_if(users_.begin(), users_.end(), [](Handle<Container> user) {
+            return !Container::resolve(user);
+        }), users_.end());
+    }
+    users_.push_back(container);
+}
+
+// ___________________________________________________________________________
+void Style::removeUser(Handle<Container> container) {
+    // The order of the users doesn't matter, so swap with the last one
+    auto it = std::find(users_.begin(), users_.end(), container);
+    if (it != users_.end()) {
+        *it = users_.back();
+        users_.pop_back();
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Destroyed containers don't unregister themselves. Their handles don't resolve anymore and are dropped here
+ * - Apply the style to all remaining containers
+ */
+// ___________________________________________________________________________
+void Style::updateUsers(bool affectsGeometry) {
+    for (size_t index = 0; index < users_.size();) {
+        Container* container = Container::resolve(users_[index]);
+        if (!container) {
+            users_[index] = users_.back();
+            users_.pop_back();
+            continue;
+        }
+
+        container->applyStyle(affectsGeometry);
+        index++;
+    }
+}
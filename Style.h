@@ -0,0 +1,90 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_STYLE_H
+#define SWIFTIFYSFML_V0_1_STYLE_H
+
+#include <SFML/Graphics.hpp>
+#include <optional>
+#include <vector>
+#include "SlotMap.h"
+
+// Forward declaration of the container class
+class Container;
+
+/*
+ * Shadow struct. Drop shadow beneath a container's background with the same shape, moved by the offset. The blur is
+ * the width over which the shadow's edge fades out.
+ */
+struct Shadow {
+    sf::Color color = sf::Color::Transparent;
+    sf::Vector2f offset;
+    float blur = 0;
+};
+
+/*
+ * Style class. Set of appearance values that can be shared by many containers through a shared pointer, e.g., as
+ * part of a theme. Values that aren't set leave the container's own value untouched.
+ *
+ * Changing a style updates all containers using it. Color, outline, corner radius and shadow changes only invalidate
+ * the cached layers containing these containers. Only padding and spacing changes cause a layout update. A value
+ * overridden on a single container is stored with that container only, so the other containers aren't affected and
+ * the container still follows the style's other values.
+ */
+class Style {
+public:
+    // Constructor and destructor
+    Style() = default;
+    ~Style() = default;
+
+    // Copy the values of another style. The containers using the other style aren't taken over
+    Style(const Style& other);
+    Style& operator=(const Style&) = delete;
+
+    // Setter functions. Each one updates all containers using the style
+    void setBackground(sf::Color color);
+    void setOutline(sf::Color color, float thickness);
+    void setCornerRadius(float cornerRadius);
+    void setShadow(Shadow shadow);
+    void setPaddingProportions(sf::Vector2f paddingProportions);
+    void setSpacingProportions(sf::Vector2f spacingProportions);
+
+    // Take over all values of another style at once, e.g., to switch themes. Updates all containers only once and
+    // only causes a layout update if padding or spacing change
+    void assign(const Style& other);
+
+    // Getter functions. Return an empty optional if the value isn't set
+    [[nodiscard]] const std::optional<sf::Color>& getBackground() const;
+    [[nodiscard]] const std::optional<sf::Color>& getOutlineColor() const;
+    [[nodiscard]] float getOutlineThickness() const;
+    [[nodiscard]] const std::optional<float>& getCornerRadius() const;
+    [[nodiscard]] const std::optional<Shadow>& getShadow() const;
+    [[nodiscard]] const std::optional<sf::Vector2f>& getPaddingProportions() const;
+    [[nodiscard]] const std::optional<sf::Vector2f>& getSpacingProportions() const;
+
+private:
+    // Containers register and unregister themselves when they start or stop using the style
+    friend class Container;
+    void addUser(Handle<Container> container);
+    void removeUser(Handle<Container> container);
+
+    // Apply the style to all containers using it. Drops containers that don't exist anymore
+    void updateUsers(bool affectsGeometry);
+
+    // Appearance values
+    std::optional<sf::Color> backgroundColor_;
+    std::optional<sf::Color> outlineColor_;
+    float outlineThickness_ = 0;
+    std::optional<float> cornerRadius_;
+    std::optional<Shadow> shadow_;
+
+    // Layout values
+    std::optional<sf::Vector2f> paddingProportions_;
+    std::optional<sf::Vector2f> spacingProportions_;
+
+    // Handles of the containers using the style
+    std::vector<Handle<Container>> users_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_STYLE_H
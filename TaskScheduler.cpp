@@ -0,0 +1,165 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "TaskScheduler.h"
+
+#include <iostream>
+
+// ___________________________________________________________________________
+TaskScheduler::TaskScheduler(size_t threadCount) : threadCount_(threadCount) {
+    if (threadCount_ == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        threadCount_ = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+}
+
+// ___________________________________________________________________________
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopping_ = true;
+    }
+    for (auto& [id, task]: pending_) {
+        task->cancelled = true;
+    }
+    taskQueued_.notify_all();
+
+    for (auto& worker: workers_) {
+        worker.join();
+    }
+}
+
+// ___________________________________________________________________________
+bool TaskScheduler::cancel(TaskId task) {
+    auto entry = pending_.find(task);
+    if (entry == pending_.end()) {
+        return false;
+    }
+
+    entry->second->cancelled = true;
+    return true;
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Cancel the tasks whose owners have been destroyed, so that their work can stop early
+ * - Take the finished tasks from the workers at once, so that the lock isn't held while resuming
+ * - Drop cancelled tasks, report failed ones and call the continuations of the others. A continuation may run new
+ * tasks, which are resumed in a later frame at the earliest
+ * - A continuation may also destroy the owner of a task resumed after it, so the owners are checked again right
+ * before resuming
+ */
+// ___________________________________________________________________________
+size_t TaskScheduler::resumeFinished() {
+    for (auto& [id, task]: pending_) {
+        if (!task->cancelled and !isOwnerAlive(task->owner)) {
+            task->cancelled = true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(finished_, resuming_);
+    }
+
+    size_t resumedCount = 0;
+    for (auto& task: resuming_) {
+        pending_.erase(task->id);
+        if (task->cancelled or !isOwnerAlive(task->owner)) {
+            continue;
+        }
+
+        if (task->error) {
+            try {
+                std::rethrow_exception(task->error);
+            } catch (const std::exception& exception) {
+                std::cerr << "Background task " << task->id << " failed: " << exception.what() << std::endl;
+            } catch (...) {
+                std::cerr << "Background task " << task->id << " failed." << std::endl;
+            }
+            continue;
+        }
+
+        task->resume();
+        resumedCount++;
+    }
+    resuming_.clear();
+
+    return resumedCount;
+}
+
+// ___________________________________________________________________________
+bool TaskScheduler::hasPendingTasks() const {
+    return !pending_.empty();
+}
+
+// ___________________________________________________________________________
+size_t TaskScheduler::getPendingCount() const {
+    return pending_.size();
+}
+
+// ___________________________________________________________________________
+TaskId TaskScheduler::submit(std::shared_ptr<Task> task) {
+    task->id = nextId_++;
+    pending_.emplace(task->id, task);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(task);
+    }
+    taskQueued_.notify_one();
+
+    if (workers_.empty()) {
+        for (size_t index = 0; index < threadCount_; index++) {
+            workers_.emplace_back(&TaskScheduler::runWorker, this);
+        }
+    }
+    return task->id;
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Wait for a queued task. Stop once the scheduler is stopping, leaving the queued tasks undone
+ * - Skip the work of tasks that have been cancelled while queued
+ * - Hand the task back to the UI thread, whether it has been run, skipped or has failed
+ */
+// ___________________________________________________________________________
+void TaskScheduler::runWorker() {
+    while (true) {
+        std::shared_ptr<Task> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            taskQueued_.wait(lock, [this]() { return isStopping_ or !queue_.empty(); });
+            if (isStopping_) {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        if (!task->cancelled) {
+            try {
+                task->work(task->cancelled);
+            } catch (...) {
+                task->error = std::current_exception();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_.push_back(std::move(task));
+    }
+}
+
+// ___________________________________________________________________________
+bool TaskScheduler::isOwnerAlive(const TaskOwner &owner) {
+    if (auto* container = std::get_if<ContainerHandle>(&owner)) {
+        return Container::resolve(*container) != nullptr;
+    }
+    if (auto* component = std::get_if<UIComponentHandle>(&owner)) {
+        return UIComponent::resolve(*component) != nullptr;
+    }
+    return true;
+}
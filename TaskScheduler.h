@@ -0,0 +1,129 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_TASKSCHEDULER_H
+#define SWIFTIFYSFML_V0_1_TASKSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include "Container.h"
+
+// Identifier of a background task. Zero is never assigned
+using TaskId = std::uint64_t;
+
+// Element owning a background task. Once it has been destroyed, the task is cancelled. Tasks without an owner only
+// end with the scheduler or when they are cancelled explicitly
+using TaskOwner = std::variant<std::monostate, ContainerHandle, UIComponentHandle>;
+
+/*
+ * TaskScheduler class. Runs work on a pool of worker threads and resumes with a continuation on the UI thread. The
+ * main loop resumes the continuations of all finished tasks once per frame, after the events have been dispatched,
+ * so continuations may change the tree and the observables like any callback, while the work itself must not touch
+ * them. A task is cancelled when its owning element is destroyed: its continuation is dropped, and the work can poll
+ * the cancellation flag it receives to stop early. Workers are only started with the first task.
+ */
+class TaskScheduler {
+public:
+    // Constructor and destructor. Without a thread count, one thread less than the hardware supports is used, but at
+    // least one. The destructor cancels all tasks and waits for the running ones to return
+    explicit TaskScheduler(size_t threadCount = 0);
+    ~TaskScheduler();
+
+    // Delete copy constructor and copy assignment operator. The workers refer to the scheduler
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    // Run the work on a worker thread and pass its result to the continuation on the UI thread at the next frame
+    // boundary. The work is called with the cancellation flag of the task and returns the result, or nothing if the
+    // continuation takes no argument. Exceptions thrown by the work are reported instead of resuming. Must be called
+    // on the UI thread
+    template<typename Work, typename Continuation>
+    TaskId run(Work work, Continuation continuation, TaskOwner owner = {});
+
+    // Cancel a task. Its continuation isn't called anymore. Returns false if the task has already been resumed
+    bool cancel(TaskId task);
+
+    // Cancel the tasks of destroyed owners and call the continuations of the finished tasks. Called by the main loop
+    // once per frame. Returns the number of continuations called
+    size_t resumeFinished();
+
+    // Returns true if any task hasn't been resumed or dropped yet
+    [[nodiscard]] bool hasPendingTasks() const;
+    [[nodiscard]] size_t getPendingCount() const;
+
+private:
+    // Task shared between the UI thread and a worker
+    struct Task {
+        TaskId id = 0;
+        TaskOwner owner;
+        std::function<void(const std::atomic<bool>&)> work;
+        std::function<void()> resume;
+        std::atomic<bool> cancelled{false};
+        std::exception_ptr error;
+    };
+
+    // Queue a task and start the workers if they aren't running yet
+    TaskId submit(std::shared_ptr<Task> task);
+
+    // Take tasks from the queue and run their work until the scheduler stops
+    void runWorker();
+
+    // Returns true if the owner hasn't been destroyed
+    static bool isOwnerAlive(const TaskOwner& owner);
+
+    // Number of worker threads and the workers once started
+    size_t threadCount_;
+    std::vector<std::thread> workers_;
+
+    // Queued tasks and the tasks whose work has returned, shared with the workers
+    std::mutex mutex_;
+    std::condition_variable taskQueued_;
+    std::deque<std::shared_ptr<Task>> queue_;
+    std::vector<std::shared_ptr<Task>> finished_;
+    bool isStopping_ = false;
+
+    // Tasks that haven't been resumed or dropped yet. Only used on the UI thread
+    std::unordered_map<TaskId, std::shared_ptr<Task>> pending_;
+    TaskId nextId_ = 1;
+
+    // Finished tasks being resumed. Kept to reuse its memory
+    std::vector<std::shared_ptr<Task>> resuming_;
+};
+
+// ___________________________________________________________________________
+template<typename Work, typename Continuation>
+TaskId TaskScheduler::run(Work work, Continuation continuation, TaskOwner owner) {
+    using Result = std::invoke_result_t<Work&, const std::atomic<bool>&>;
+
+    auto task = std::make_shared<Task>();
+    task->owner = owner;
+    if constexpr (std::is_void_v<Result>) {
+        task->work = std::move(work);
+        task->resume = std::move(continuation);
+    } else {
+        // The result is written by the worker and read on the UI thread after the task has been handed back
+        auto result = std::make_shared<std::optional<Result>>();
+        task->work = [work = std::move(work), result](const std::atomic<bool>& cancelled) mutable {
+            result->emplace(work(cancelled));
+        };
+        task->resume = [continuation = std::move(continuation), result]() mutable {
+            continuation(std::move(**result));
+        };
+    }
+    return submit(std::move(task));
+}
+
+#endif //SWIFTIFYSFML_V0_1_TASKSCHEDULER_H
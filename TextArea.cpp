@@ -0,0 +1,678 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "TextArea.h"
+#include "ShapeGeometry.h"
+#include "TextGeometry.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ___________________________________________________________________________
+TextArea::TextArea(std::string name, const sf::Vector2f &sizeProportions, std::shared_ptr<sf::Font> font,
+                   unsigned characterSize)
+: UIComponent(std::move(name), sizeProportions), font_(std::move(font)), characterSize_(characterSize) {
+    paragraphs_.push_back({});
+    asciiAdvances_.fill(-1);
+
+    // Key and text events arrive through the focus manager, clicks through the tree
+    setFocusable(true);
+    addHandledCallbackTypes(toCallbackMask(CallbackType::Click));
+}
+
+// ___________________________________________________________________________
+void TextArea::setText(std::string text) {
+    paragraphs_.clear();
+    size_t start = 0;
+    for (size_t lineBreak = text.find('\n'); lineBreak != std::string::npos; lineBreak = text.find('\n', start)) {
+        paragraphs_.push_back({lineBreak - start});
+        start = lineBreak + 1;
+    }
+    paragraphs_.push_back({text.size() - start});
+
+    buffer_ = PieceTable(std::move(text));
+    validPrefixCount_ = 0;
+    rowCount_ = paragraphs_.size();
+    cursor_ = 0;
+    preferredX_ = -1;
+    scrollOffset_ = 0;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Find the paragraph containing the offset and discard its wrapping. The other paragraphs keep theirs
+ * - Without line breaks, the paragraph only grows. Otherwise, it ends at the first line break, the lines in between
+ * become new paragraphs, and the last one continues with the rest of the original paragraph
+ * - The cursor moves along if the text is inserted before or at it, so typing keeps it after the typed text
+ */
+// ___________________________________________________________________________
+void TextArea::insertText(size_t offset, const std::string &text) {
+    if (text.empty()) {
+        return;
+    }
+    offset = std::min(offset, buffer_.getLength());
+
+    size_t index = findParagraphAtOffset(offset);
+    invalidateParagraph(index);
+    size_t inner = offset - paragraphs_[index].start;
+
+    size_t lineBreak = text.find('\n');
+    if (lineBreak == std::string::npos) {
+        paragraphs_[index].length += text.size();
+    } else {
+        size_t tail = paragraphs_[index].length - inner;
+        paragraphs_[index].length = inner + lineBreak;
+
+        std::vector<Paragraph> insertedParagraphs;
+        size_t start = lineBreak + 1;
+        for (lineBreak = text.find('\n', start); lineBreak != std::string::npos; lineBreak = text.find('\n', start)) {
+            insertedParagraphs.push_back({lineBreak - start});
+            start = lineBreak + 1;
+        }
+        insertedParagraphs.push_back({text.size() - start + tail});
+
+        paragraphs_.insert(paragraphs_.begin() + static_cast<std::ptrdiff_t>(index) + 1, insertedParagraphs.begin(),
+                           insertedParagraphs.end());
+        rowCount_ += insertedParagraphs.size();
+    }
+
+    buffer_.insert(offset, text);
+    if (cursor_ >= offset) {
+        cursor_ += text.size();
+    }
+    preferredX_ = -1;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void TextArea::insertText(const std::string &text) {
+    insertText(cursor_, text);
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Find the paragraphs containing both ends of the range. The first one is joined with the rest of the last one,
+ * and the paragraphs after the first one up to the last one are removed with their rows
+ * - The cursor moves to the start of the range if it was inside, and back by the length if it was after it
+ */
+// ___________________________________________________________________________
+void TextArea::eraseText(size_t offset, size_t length) {
+    offset = std::min(offset, buffer_.getLength());
+    length = std::min(length, buffer_.getLength() - offset);
+    if (length == 0) {
+        return;
+    }
+
+    size_t first = findParagraphAtOffset(offset);
+    size_t last = findParagraphAtOffset(offset + length);
+    size_t inner = offset - paragraphs_[first].start;
+    size_t tail = paragraphs_[last].start + paragraphs_[last].length - (offset + length);
+
+    for (size_t index = first + 1; index <= last; index++) {
+        rowCount_ -= getRows(paragraphs_[index]);
+    }
+    invalidateParagraph(first);
+    paragraphs_[first].length = inner + tail;
+    paragraphs_.erase(paragraphs_.begin() + static_cast<std::ptrdiff_t>(first) + 1,
+                      paragraphs_.begin() + static_cast<std::ptrdiff_t>(last) + 1);
+
+    buffer_.erase(offset, length);
+    if (cursor_ >= offset + length) {
+        cursor_ -= length;
+    } else if (cursor_ > offset) {
+        cursor_ = offset;
+    }
+    preferredX_ = -1;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void TextArea::setCursor(size_t offset) {
+    offset = std::min(offset, buffer_.getLength());
+    while (offset > 0 and offset < buffer_.getLength() and (buffer_.at(offset) & 0xC0) == 0x80) {
+        offset--;
+    }
+
+    cursor_ = offset;
+    preferredX_ = -1;
+    scrollToCursor();
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void TextArea::setTextColor(sf::Color color) {
+    textColor_ = color;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void TextArea::setCursorColor(sf::Color color) {
+    cursorColor_ = color;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void TextArea::setPadding(float padding) {
+    padding_ = padding;
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void TextArea::setScrollOffset(float scrollOffset) {
+    scrollOffset = std::clamp(scrollOffset, 0.f, getMaxScrollOffset());
+    if (scrollOffset != scrollOffset_) {
+        scrollOffset_ = scrollOffset;
+        requestRenderUpdate();
+    }
+}
+
+// ___________________________________________________________________________
+std::string TextArea::getText() const {
+    return buffer_.getText();
+}
+
+// ___________________________________________________________________________
+const PieceTable &TextArea::getBuffer() const {
+    return buffer_;
+}
+
+// ___________________________________________________________________________
+size_t TextArea::getCursor() const {
+    return cursor_;
+}
+
+// ___________________________________________________________________________
+float TextArea::getScrollOffset() const {
+    return scrollOffset_;
+}
+
+// ___________________________________________________________________________
+size_t TextArea::getParagraphCount() const {
+    return paragraphs_.size();
+}
+
+// ___________________________________________________________________________
+size_t TextArea::getRowCount() const {
+    return rowCount_;
+}
+
+// ___________________________________________________________________________
+void TextArea::draw(sf::RenderTarget &target, sf::RenderStates states) {
+    if (!isVisible_) {
+        return;
+    }
+
+    if (!glyphVertices_.empty()) {
+        states.texture = &font_->getTexture(characterSize_);
+        target.draw(glyphVertices_.data(), glyphVertices_.size(), sf::Triangles, states);
+    }
+    if (!cursorVertices_.empty()) {
+        states.texture = nullptr;
+        target.draw(cursorVertices_.data(), cursorVertices_.size(), sf::Triangles, states);
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Text events insert the typed character. Backspace erases the character before the cursor, other control
+ * characters are ignored. Tab isn't inserted either
+ * - The arrow, page, home and end keys move the cursor, the delete key erases the character after it. Other keys
+ * aren't handled, so that Tab moves the focus
+ * - Clicks move the cursor to the clicked character, the mouse wheel scrolls by three rows. Mouse wheel events reach
+ * all elements, so the cursor position is checked here
+ */
+// ___________________________________________________________________________
+bool TextArea::handleEvent(const sf::Event &event) {
+    sf::FloatRect bounds(position_, size_);
+
+    switch (event.type) {
+        case sf::Event::TextEntered: {
+            std::uint32_t character = event.text.unicode;
+            if (character == '\b') {
+                size_t previous = stepBackward(cursor_);
+                eraseText(previous, cursor_ - previous);
+            } else if (character == '\r' or character == '\n') {
+                insertText("\n");
+            } else if (character >= 32 and character != 127) {
+                insertText(encodeUtf8(character));
+            } else {
+                return false;
+            }
+            scrollToCursor();
+            return true;
+        }
+        case sf::Event::KeyPressed: {
+            auto pageRows = static_cast<long>(std::max(1.f, std::floor(getViewHeight() / getLineHeight())));
+            switch (event.key.code) {
+                case sf::Keyboard::Left:
+                    setCursor(stepBackward(cursor_));
+                    break;
+                case sf::Keyboard::Right:
+                    setCursor(stepForward(cursor_));
+                    break;
+                case sf::Keyboard::Up:
+                    moveCursorVertically(-1);
+                    break;
+                case sf::Keyboard::Down:
+                    moveCursorVertically(1);
+                    break;
+                case sf::Keyboard::PageUp:
+                    moveCursorVertically(-pageRows);
+                    break;
+                case sf::Keyboard::PageDown:
+                    moveCursorVertically(pageRows);
+                    break;
+                case sf::Keyboard::Home:
+                    setCursor(paragraphs_[findParagraphAtOffset(cursor_)].start);
+                    break;
+                case sf::Keyboard::End: {
+                    const Paragraph& paragraph = paragraphs_[findParagraphAtOffset(cursor_)];
+                    setCursor(paragraph.start + paragraph.length);
+                    break;
+                }
+                case sf::Keyboard::Delete:
+                    eraseText(cursor_, stepForward(cursor_) - cursor_);
+                    scrollToCursor();
+                    break;
+                default:
+                    return false;
+            }
+            return true;
+        }
+        case sf::Event::MouseButtonPressed: {
+            sf::Vector2f mousePosition(static_cast<float>(event.mouseButton.x),
+                                       static_cast<float>(event.mouseButton.y));
+            if (event.mouseButton.button != sf::Mouse::Left or !bounds.contains(mousePosition)) {
+                return false;
+            }
+            float rowPosition = (mousePosition.y - position_.y - padding_ + scrollOffset_) / getLineHeight();
+            setCursor(findOffset(static_cast<size_t>(std::max(0.f, rowPosition)),
+                                 mousePosition.x - position_.x - padding_));
+            return true;
+        }
+        case sf::Event::MouseWheelScrolled: {
+            sf::Vector2f mousePosition(static_cast<float>(event.mouseWheelScroll.x),
+                                       static_cast<float>(event.mouseWheelScroll.y));
+            if (event.mouseWheelScroll.wheel != sf::Mouse::VerticalWheel or !bounds.contains(mousePosition)) {
+                return false;
+            }
+            setScrollOffset(scrollOffset_ - std::round(event.mouseWheelScroll.delta * 3) * getLineHeight());
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Compute the size from the proportions. If the width for the text changed, all wrapping is discarded, which is
+ * the only case touching every paragraph
+ * - Clamp the scroll offset, since the text or the size may have shrunk, and rebuild the visible rows
+ */
+// ___________________________________________________________________________
+void TextArea::updateRenderInformation() {
+    size_ = sf::Vector2f(parentSize_.x * sizeProportions_.x, parentSize_.y * sizeProportions_.y);
+
+    float wrapWidth = std::max(0.f, size_.x - 2 * padding_);
+    if (wrapWidth != wrapWidth_) {
+        wrapWidth_ = wrapWidth;
+        for (auto& paragraph: paragraphs_) {
+            paragraph.rowCount = 0;
+        }
+        rowCount_ = paragraphs_.size();
+        validPrefixCount_ = 0;
+    }
+
+    scrollOffset_ = std::clamp(scrollOffset_, 0.f, getMaxScrollOffset());
+    buildVertices();
+    needRenderUpdate_ = false;
+}
+
+// ___________________________________________________________________________
+void TextArea::collectMemoryUsage(MemoryReport &report) const {
+    UIComponent::collectMemoryUsage(report);
+    report.uiComponentBytes += sizeof(TextArea) - sizeof(UIComponent);
+    report.layoutBytes += paragraphs_.capacity() * sizeof(Paragraph) + scratchText_.capacity() +
+                          scratchRowStarts_.capacity() * sizeof(size_t);
+    report.renderBytes += (glyphVertices_.capacity() + cursorVertices_.capacity()) * sizeof(sf::Vertex);
+    report.assetBytes += buffer_.getMemoryUsage();
+}
+
+// ___________________________________________________________________________
+size_t TextArea::getRows(const Paragraph &paragraph) {
+    return std::max<size_t>(paragraph.rowCount, 1);
+}
+
+// ___________________________________________________________________________
+void TextArea::extendPrefix(size_t count) {
+    count = std::min(count, paragraphs_.size());
+    if (validPrefixCount_ == 0 and count > 0) {
+        paragraphs_[0].start = 0;
+        paragraphs_[0].firstRow = 0;
+        validPrefixCount_ = 1;
+    }
+
+    for (size_t index = validPrefixCount_; index < count; index++) {
+        const Paragraph& previous = paragraphs_[index - 1];
+        paragraphs_[index].start = previous.start + previous.length + 1;
+        paragraphs_[index].firstRow = previous.firstRow + getRows(previous);
+    }
+    validPrefixCount_ = std::max(validPrefixCount_, count);
+}
+
+// ___________________________________________________________________________
+void TextArea::invalidatePrefix(size_t index) {
+    validPrefixCount_ = std::min(validPrefixCount_, index + 1);
+}
+
+// ___________________________________________________________________________
+size_t TextArea::stepBackward(size_t offset) const {
+    if (offset == 0) {
+        return 0;
+    }
+    offset--;
+    while (offset > 0 and (buffer_.at(offset) & 0xC0) == 0x80) {
+        offset--;
+    }
+    return offset;
+}
+
+// ___________________________________________________________________________
+size_t TextArea::stepForward(size_t offset) const {
+    if (offset >= buffer_.getLength()) {
+        return buffer_.getLength();
+    }
+    offset++;
+    while (offset < buffer_.getLength() and (buffer_.at(offset) & 0xC0) == 0x80) {
+        offset++;
+    }
+    return offset;
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Extend the prefix sums until they cover the offset. Edits invalidate them after the edited paragraph only, so
+ * this usually computes a few paragraphs at most
+ * - Binary search for the last paragraph starting at or before the offset
+ */
+// ___________________________________________________________________________
+size_t TextArea::findParagraphAtOffset(size_t offset) {
+    extendPrefix(1);
+    while (validPrefixCount_ < paragraphs_.size()) {
+        const Paragraph& last = paragraphs_[validPrefixCount_ - 1];
+        if (last.start + last.length >= offset) {
+            break;
+        }
+        extendPrefix(validPrefixCount_ + 1);
+    }
+
+    auto end = paragraphs_.begin() + static_cast<std::ptrdiff_t>(validPrefixCount_);
+    auto next = std::upper_bound(paragraphs_.begin(), end, offset,
+                                 [](size_t value, const Paragraph& paragraph) { return value < paragraph.start; });
+    return static_cast<size_t>(next - paragraphs_.begin()) - 1;
+}
+
+// ___________________________________________________________________________
+size_t TextArea::findParagraphAtRow(size_t row) {
+    extendPrefix(1);
+    while (validPrefixCount_ < paragraphs_.size()) {
+        const Paragraph& last = paragraphs_[validPrefixCount_ - 1];
+        if (last.firstRow + getRows(last) > row) {
+            break;
+        }
+        extendPrefix(validPrefixCount_ + 1);
+    }
+
+    auto end = paragraphs_.begin() + static_cast<std::ptrdiff_t>(validPrefixCount_);
+    auto next = std::upper_bound(paragraphs_.begin(), end, row,
+                                 [](size_t value, const Paragraph& paragraph) { return value < paragraph.firstRow; });
+    return static_cast<size_t>(next - paragraphs_.begin()) - 1;
+}
+
+// ___________________________________________________________________________
+void TextArea::invalidateParagraph(size_t index) {
+    Paragraph& paragraph = paragraphs_[index];
+    if (paragraph.rowCount > 1) {
+        rowCount_ -= paragraph.rowCount - 1;
+    }
+    paragraph.rowCount = 0;
+    invalidatePrefix(index);
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Copy the paragraph's text out of the piece table and accumulate the advances of its characters. Nothing is
+ * wrapped before the width is known
+ * - Once a character doesn't fit into the row anymore, start a new row after the last space of the row, or before
+ * the character if the row has no space. Spaces never start a row, they hang past its end instead
+ * - Cache the number of rows. If it changed, the rows of the later paragraphs shift, so their prefix sums are
+ * invalidated
+ */
+// ___________________________________________________________________________
+void TextArea::layoutParagraph(size_t index, std::string &text, std::vector<size_t> &rowStarts) {
+    extendPrefix(index + 1);
+    Paragraph& paragraph = paragraphs_[index];
+    text.clear();
+    buffer_.copyText(paragraph.start, paragraph.length, text);
+
+    rowStarts.assign(1, 0);
+    size_t lastSpaceEnd = 0;
+    float x = 0;
+    for (size_t position = 0; position < text.size();) {
+        std::uint32_t character;
+        size_t next = decodeUtf8(text, position, character);
+        bool isSpace = character == ' ' or character == '\t';
+        float advance = getAdvance(character);
+
+        if (not isSpace and wrapWidth_ > 0 and x + advance > wrapWidth_ and position > rowStarts.back()) {
+            size_t rowStart = lastSpaceEnd > rowStarts.back() ? lastSpaceEnd : position;
+            rowStarts.push_back(rowStart);
+            x = measure(text, rowStart, position);
+        }
+
+        x += advance;
+        if (isSpace) {
+            lastSpaceEnd = next;
+        }
+        position = next;
+    }
+
+    if (rowStarts.size() != paragraph.rowCount) {
+        rowCount_ = rowCount_ - getRows(paragraph) + rowStarts.size();
+        paragraph.rowCount = rowStarts.size();
+        invalidatePrefix(index);
+    }
+}
+
+// ___________________________________________________________________________
+float TextArea::getAdvance(std::uint32_t character) {
+    // Kerning is left out, which only matters for proportional fonts and keeps measuring a lookup per character
+    if (character == '\t') {
+        return 4 * getAdvance(' ');
+    }
+    if (character < asciiAdvances_.size()) {
+        float& advance = asciiAdvances_[character];
+        if (advance < 0) {
+            advance = font_->getGlyph(character, characterSize_, false).advance;
+        }
+        return advance;
+    }
+    return font_->getGlyph(character, characterSize_, false).advance;
+}
+
+// ___________________________________________________________________________
+float TextArea::measure(const std::string &text, size_t begin, size_t end) {
+    float x = 0;
+    for (size_t position = begin; position < end;) {
+        std::uint32_t character;
+        position = decodeUtf8(text, position, character);
+        x += getAdvance(character);
+    }
+    return x;
+}
+
+// ___________________________________________________________________________
+size_t TextArea::findOffsetAtX(const std::string &text, size_t begin, size_t end, float x) {
+    float characterX = 0;
+    for (size_t position = begin; position < end;) {
+        std::uint32_t character;
+        size_t next = decodeUtf8(text, position, character);
+        float advance = getAdvance(character);
+        if (x < characterX + advance / 2) {
+            return position;
+        }
+        characterX += advance;
+        position = next;
+    }
+    return end;
+}
+
+// ___________________________________________________________________________
+sf::Vector2f TextArea::locate(size_t offset, size_t &row) {
+    size_t index = findParagraphAtOffset(offset);
+    layoutParagraph(index, scratchText_, scratchRowStarts_);
+    const Paragraph& paragraph = paragraphs_[index];
+
+    size_t inner = offset - paragraph.start;
+    auto rowEnd = std::upper_bound(scratchRowStarts_.begin(), scratchRowStarts_.end(), inner);
+    auto paragraphRow = static_cast<size_t>(rowEnd - scratchRowStarts_.begin() - 1);
+    row = paragraph.firstRow + paragraphRow;
+    return {measure(scratchText_, scratchRowStarts_[paragraphRow], inner), static_cast<float>(row) * getLineHeight()};
+}
+
+// ___________________________________________________________________________
+size_t TextArea::findOffset(size_t row, float x) {
+    size_t index = findParagraphAtRow(row);
+    layoutParagraph(index, scratchText_, scratchRowStarts_);
+    const Paragraph& paragraph = paragraphs_[index];
+
+    // Wrapping the paragraph may have changed its number of rows
+    size_t paragraphRow = std::min(row - std::min(row, paragraph.firstRow), scratchRowStarts_.size() - 1);
+    size_t begin = scratchRowStarts_[paragraphRow];
+    size_t end = paragraphRow + 1 < scratchRowStarts_.size() ? scratchRowStarts_[paragraphRow + 1]
+                                                             : scratchText_.size();
+    return paragraph.start + findOffsetAtX(scratchText_, begin, end, x);
+}
+
+// ___________________________________________________________________________
+void TextArea::moveCursorVertically(long rows) {
+    size_t row;
+    float x = locate(cursor_, row).x;
+    float preferredX = preferredX_ < 0 ? x : preferredX_;
+
+    long targetRow = static_cast<long>(row) + rows;
+    if (targetRow < 0) {
+        cursor_ = 0;
+    } else if (static_cast<size_t>(targetRow) >= rowCount_) {
+        cursor_ = buffer_.getLength();
+    } else {
+        cursor_ = findOffset(static_cast<size_t>(targetRow), preferredX);
+    }
+
+    // Keep the x-position for the next vertical move, even if the target row is shorter
+    preferredX_ = preferredX;
+    scrollToCursor();
+    requestRenderUpdate();
+}
+
+// ___________________________________________________________________________
+void TextArea::scrollToCursor() {
+    size_t row;
+    float top = locate(cursor_, row).y;
+    float bottom = top + getLineHeight();
+
+    if (top < scrollOffset_) {
+        setScrollOffset(top);
+    } else if (bottom > scrollOffset_ + getViewHeight()) {
+        setScrollOffset(bottom - getViewHeight());
+    }
+}
+
+// ___________________________________________________________________________
+float TextArea::getLineHeight() const {
+    return std::max(font_->getLineSpacing(characterSize_), 1.f);
+}
+
+// ___________________________________________________________________________
+float TextArea::getViewHeight() const {
+    return std::max(0.f, size_.y - 2 * padding_);
+}
+
+// ___________________________________________________________________________
+float TextArea::getMaxScrollOffset() const {
+    return std::max(0.f, static_cast<float>(rowCount_) * getLineHeight() - getViewHeight());
+}
+
+// ___________________________________________________________________________
+/*
+ * Function logic walk-through:
+ * - Only rows completely inside the view are drawn, since the text area doesn't clip
+ * - Start at the paragraph containing the first visible row and wrap the paragraphs until the view is filled
+ * - Each visible character becomes a quad with the glyph's texture rectangle, positioned on the row's baseline.
+ * Spaces have no quad
+ * - The cursor is a thin quad at the cursor offset. An offset between two rows of a paragraph belongs to the later
+ * row
+ */
+// ___________________________________________________________________________
+void TextArea::buildVertices() {
+    glyphVertices_.clear();
+    cursorVertices_.clear();
+
+    float lineHeight = getLineHeight();
+    auto firstRow = static_cast<size_t>(std::ceil(scrollOffset_ / lineHeight));
+    auto endRow = static_cast<size_t>(std::floor((scrollOffset_ + getViewHeight()) / lineHeight));
+    sf::Vector2f origin(position_.x + padding_, position_.y + padding_ - scrollOffset_);
+    bool showCursor = isFocused();
+
+    for (size_t index = findParagraphAtRow(firstRow); index < paragraphs_.size(); index++) {
+        layoutParagraph(index, scratchText_, scratchRowStarts_);
+        extendPrefix(index + 1);
+        const Paragraph& paragraph = paragraphs_[index];
+        if (paragraph.firstRow >= endRow) {
+            break;
+        }
+
+        for (size_t paragraphRow = 0; paragraphRow < scratchRowStarts_.size(); paragraphRow++) {
+            size_t row = paragraph.firstRow + paragraphRow;
+            if (row < firstRow) {
+                continue;
+            }
+            if (row >= endRow) {
+                break;
+            }
+
+            bool isLastRow = paragraphRow + 1 == scratchRowStarts_.size();
+            size_t begin = scratchRowStarts_[paragraphRow];
+            size_t end = isLastRow ? scratchText_.size() : scratchRowStarts_[paragraphRow + 1];
+            float top = origin.y + static_cast<float>(row) * lineHeight;
+            float baseline = top + static_cast<float>(characterSize_);
+
+            float x = origin.x;
+            for (size_t position = begin; position < end;) {
+                std::uint32_t character;
+                position = decodeUtf8(scratchText_, position, character);
+                if (character != ' ' and character != '\t') {
+                    appendGlyph(glyphVertices_, font_->getGlyph(character, characterSize_, false),
+                                sf::Vector2f(x, baseline), textColor_);
+                }
+                x += getAdvance(character);
+            }
+
+            size_t cursorInner = cursor_ - std::min(cursor_, paragraph.start);
+            if (showCursor and cursor_ >= paragraph.start + begin and (cursorInner < end or isLastRow) and
+                cursorInner <= paragraph.length) {
+                float cursorX = origin.x + measure(scratchText_, begin, cursorInner);
+                appendRectangle(cursorVertices_, {cursorX, top, 1, lineHeight}, cursorColor_);
+            }
+        }
+    }
+}
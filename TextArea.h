@@ -0,0 +1,169 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_TEXTAREA_H
+#define SWIFTIFYSFML_V0_1_TEXTAREA_H
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include "UIComponent.h"
+#include "PieceTable.h"
+
+/*
+ * TextArea class. Editable multi-line text for logs and configuration files. The text is stored in a piece table,
+ * so edits don't move the text, and split into paragraphs at the line breaks. Each paragraph caches the number of
+ * rows it wraps into, and an edit only discards the cache of the paragraphs it touches. Paragraphs are wrapped when
+ * they become visible, until then they count as a single row. Only the visible rows are turned into glyph vertices,
+ * so the cost of a keystroke depends on the edited paragraph and the size of the view, not on the length of the text.
+ * Offsets are in bytes of the UTF-8 encoded text. The text area is focusable and takes key and text events from the
+ * focus manager.
+ */
+class TextArea : public UIComponent {
+public:
+    // Constructor and destructor. The font is shared with the asset cache
+    TextArea(std::string name, const sf::Vector2f& sizeProportions, std::shared_ptr<sf::Font> font,
+             unsigned characterSize = 16);
+    ~TextArea() override = default;
+
+    // Replace the whole text. Moves the cursor to the start and scrolls to the top
+    void setText(std::string text);
+
+    // Insert text at an offset or at the cursor, or erase a range. The cursor stays on the same character
+    void insertText(size_t offset, const std::string& text);
+    void insertText(const std::string& text);
+    void eraseText(size_t offset, size_t length);
+
+    // Move the cursor to an offset. Offsets inside a character are moved to its start. Scrolls the cursor into view
+    void setCursor(size_t offset);
+
+    // Appearance
+    void setTextColor(sf::Color color);
+    void setCursorColor(sf::Color color);
+    void setPadding(float padding);
+
+    // Scroll to a vertical offset in pixels. Clamped to the rows of the text
+    void setScrollOffset(float scrollOffset);
+
+    // Get the whole text. Copies the text, so it shouldn't be called per frame on large texts
+    [[nodiscard]] std::string getText() const;
+
+    // Get the text storage, e.g., to read ranges of the text without copying it all
+    [[nodiscard]] const PieceTable& getBuffer() const;
+
+    // Get the cursor offset, the scroll offset in pixels and the number of paragraphs and rows. Paragraphs that haven't
+    // been wrapped yet count as a single row
+    [[nodiscard]] size_t getCursor() const;
+    [[nodiscard]] float getScrollOffset() const;
+    [[nodiscard]] size_t getParagraphCount() const;
+    [[nodiscard]] size_t getRowCount() const;
+
+    // UI-related functions
+    void draw(sf::RenderTarget& target, sf::RenderStates states) override;
+    bool handleEvent(const sf::Event& event) override;
+    void updateRenderInformation() override;
+    void collectMemoryUsage(MemoryReport& report) const override;
+
+private:
+    // Line of the text, without its line break. The start offset and the first row are prefix sums, which are only
+    // valid for the paragraphs before validPrefixCount_. A row count of 0 means the paragraph hasn't been wrapped yet
+    struct Paragraph {
+        size_t length = 0;
+        size_t start = 0;
+        size_t firstRow = 0;
+        size_t rowCount = 0;
+    };
+
+    // Get the rows a paragraph takes up, counting unwrapped paragraphs as a single row
+    static size_t getRows(const Paragraph& paragraph);
+
+    // Compute the prefix sums of the paragraphs up to the index, exclusive
+    void extendPrefix(size_t count);
+
+    // Invalidate the prefix sums after the paragraph at the index
+    void invalidatePrefix(size_t index);
+
+    // Get the offset of the character before or after an offset, skipping the continuation bytes of UTF-8 sequences
+    [[nodiscard]] size_t stepBackward(size_t offset) const;
+    [[nodiscard]] size_t stepForward(size_t offset) const;
+
+    // Get the index of the paragraph containing an offset or a row. The line break after a paragraph belongs to it.
+    // Rows past the end give the last paragraph
+    size_t findParagraphAtOffset(size_t offset);
+    size_t findParagraphAtRow(size_t row);
+
+    // Discard the wrapping of a paragraph, e.g., after it has been edited
+    void invalidateParagraph(size_t index);
+
+    // Wrap a paragraph into the width of the text area. Sets the paragraph's text and the start offsets of its rows
+    // relative to the paragraph, and caches its row count
+    void layoutParagraph(size_t index, std::string& text, std::vector<size_t>& rowStarts);
+
+    // Get the horizontal advance of a character
+    float getAdvance(std::uint32_t character);
+
+    // Get the x-position of an offset inside a row, and the offset inside the row closest to an x-position
+    float measure(const std::string& text, size_t begin, size_t end);
+    size_t findOffsetAtX(const std::string& text, size_t begin, size_t end, float x);
+
+    // Get the row and the x-position of an offset, relative to the first row of the text
+    sf::Vector2f locate(size_t offset, size_t& row);
+
+    // Get the offset closest to a row and an x-position
+    size_t findOffset(size_t row, float x);
+
+    // Move the cursor by a number of rows, keeping its x-position
+    void moveCursorVertically(long rows);
+
+    // Scroll so that the cursor row is fully visible
+    void scrollToCursor();
+
+    // Get the height of a row, the height available for the rows and the largest scroll offset
+    [[nodiscard]] float getLineHeight() const;
+    [[nodiscard]] float getViewHeight() const;
+    [[nodiscard]] float getMaxScrollOffset() const;
+
+    // Rebuild the vertices of the fully visible rows and the cursor. Wraps the visible paragraphs on the way
+    void buildVertices();
+
+    // Font and character size of the text
+    std::shared_ptr<sf::Font> font_;
+    unsigned characterSize_;
+
+    // Text storage and its paragraphs. The number of rows is kept up to date with every wrapped paragraph
+    PieceTable buffer_;
+    std::vector<Paragraph> paragraphs_;
+    size_t validPrefixCount_ = 0;
+    size_t rowCount_ = 1;
+
+    // Width the paragraphs have been wrapped into. Wrapping is discarded once it changes
+    float wrapWidth_ = -1;
+
+    // Cursor offset and the x-position kept while moving vertically. Negative if there is none
+    size_t cursor_ = 0;
+    float preferredX_ = -1;
+
+    // Vertical scroll offset in pixels
+    float scrollOffset_ = 0;
+
+    // Appearance
+    sf::Color textColor_ = sf::Color::White;
+    sf::Color cursorColor_ = sf::Color::White;
+    float padding_ = 4;
+
+    // Advances of the ASCII characters, cached since they make up most of the text. Negative until measured
+    std::array<float, 128> asciiAdvances_;
+
+    // Glyph vertices of the visible rows and the cursor quad, rebuilt with the render information
+    std::vector<sf::Vertex> glyphVertices_;
+    std::vector<sf::Vertex> cursorVertices_;
+
+    // Scratch memory for the paragraph text and row starts, reused between layouts
+    std::string scratchText_;
+    std::vector<size_t> scratchRowStarts_;
+};
+
+#endif //SWIFTIFYSFML_V0_1_TEXTAREA_H
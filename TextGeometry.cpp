@@ -0,0 +1,56 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#include "TextGeometry.h"
+
+#include <algorithm>
+
+// ___________________________________________________________________________
+size_t decodeUtf8(std::string_view text, size_t position, std::uint32_t& character) {
+    auto byte = static_cast<unsigned char>(text[position]);
+    size_t length = byte < 0xC0 ? 1 : byte < 0xE0 ? 2 : byte < 0xF0 ? 3 : 4;
+    character = length == 1 ? byte : byte & (0x7Fu >> length);
+
+    size_t end = std::min(position + length, text.size());
+    for (size_t index = position + 1; index < end; index++) {
+        character = (character << 6) | (static_cast<unsigned char>(text[index]) & 0x3Fu);
+    }
+    return end;
+}
+
+// ___________________________________________________________________________
+std::string encodeUtf8(std::uint32_t character) {
+    std::string text;
+    if (character < 0x80) {
+        text += static_cast<char>(character);
+    } else if (character < 0x800) {
+        text += static_cast<char>(0xC0 | (character >> 6));
+        text += static_cast<char>(0x80 | (character & 0x3F));
+    } else if (character < 0x10000) {
+        text += static_cast<char>(0xE0 | (character >> 12));
+        text += static_cast<char>(0x80 | ((character >> 6) & 0x3F));
+        text += static_cast<char>(0x80 | (character & 0x3F));
+    } else {
+        text += static_cast<char>(0xF0 | (character >> 18));
+        text += static_cast<char>(0x80 | ((character >> 12) & 0x3F));
+        text += static_cast<char>(0x80 | ((character >> 6) & 0x3F));
+        text += static_cast<char>(0x80 | (character & 0x3F));
+    }
+    return text;
+}
+
+// ___________________________________________________________________________
+void appendGlyph(std::vector<sf::Vertex>& vertices, const sf::Glyph& glyph, sf::Vector2f position, sf::Color color) {
+    sf::FloatRect bounds(position.x + glyph.bounds.left, position.y + glyph.bounds.top, glyph.bounds.width,
+                         glyph.bounds.height);
+    sf::FloatRect texture(glyph.textureRect);
+
+    sf::Vertex topLeft({bounds.left, bounds.top}, color, {texture.left, texture.top});
+    sf::Vertex topRight({bounds.left + bounds.width, bounds.top}, color, {texture.left + texture.width, texture.top});
+    sf::Vertex bottomLeft({bounds.left, bounds.top + bounds.height}, color,
+                          {texture.left, texture.top + texture.height});
+    sf::Vertex bottomRight({bounds.left + bounds.width, bounds.top + bounds.height}, color,
+                           {texture.left + texture.width, texture.top + texture.height});
+    vertices.insert(vertices.end(), {topLeft, topRight, bottomLeft, bottomLeft, topRight, bottomRight});
+}
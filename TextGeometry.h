@@ -0,0 +1,29 @@
+//
+// Created by Luca Schmitt on 19.10.26.
+//
+
+#ifndef SWIFTIFYSFML_V0_1_TEXTGEOMETRY_H
+#define SWIFTIFYSFML_V0_1_TEXTGEOMETRY_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Glyph geometry of text drawn by UI components. Each glyph is a textured quad referring to the glyph's rectangle in
+ * the font texture of its character size, so any amount of text of one font and size can be drawn in a single draw
+ * call with that texture. Text is UTF-8 encoded.
+ */
+
+// Decode the character at a position of UTF-8 text. Returns the position after it. Invalid bytes are single characters
+size_t decodeUtf8(std::string_view text, size_t position, std::uint32_t& character);
+
+// Encode a character as UTF-8
+std::string encodeUtf8(std::uint32_t character);
+
+// Append two triangles covering a glyph, with the origin of the glyph on the baseline at the position
+void appendGlyph(std::vector<sf::Vertex>& vertices, const sf::Glyph& glyph, sf::Vector2f position, sf::Color color);
+
+#endif //SWIFTIFYSFML_V0_1_TEXTGEOMETRY_H
@@ -4,6 +4,8 @@
 
 #include <SFML/Graphics.hpp>
 #include "UIComponent.h"
+#include "Container.h"
+#include "FocusManager.h"
 #include <string>
 
 UIComponent::UIComponent(std::string name, const sf::Vector2f &sizeProportions)
@@ -14,13 +16,31 @@ UIComponent::UIComponent(std::string name, const sf::Vector2f &sizeProportions)
 
     // Should this be true or false? And should this be renamed to isDisabled?
     isEnabled_ = true;
+
+    // Register the UI component to get a stable handle
+    handle_ = getRegistry().insert(this);
+}
+
+UIComponent::~UIComponent() {
+    // Invalidate all handles to this UI component
+    getRegistry().erase(handle_);
+}
+
+UIComponent *UIComponent::resolve(UIComponentHandle handle) {
+    return getRegistry().resolve(handle);
+}
+
+SlotMap<UIComponent> &UIComponent::getRegistry() {
+    // Constructed on first use, so it exists before any UI component
+    static SlotMap<UIComponent> registry;
+    return registry;
 }
 
 void UIComponent::setVisible(bool visible) {
     // Only update visibility and render update flag if needed
     if (isVisible_ != visible) {
         isVisible_ = visible;
-        needRenderUpdate_ = true;
+        requestRenderUpdate();
     }
 }
 
@@ -35,32 +55,154 @@ void UIComponent::setParentSize(sf::Vector2f parentSize) {
     parentSize_ = parentSize;
 
     // Update render update flag
-    needRenderUpdate_ = true;
+    requestRenderUpdate();
 }
 
 void UIComponent::setSizeProportions(sf::Vector2f sizeProportions) {
     sizeProportions_ = sizeProportions;
 
     // Update render update flag
-    needRenderUpdate_ = true;
+    requestRenderUpdate();
 }
 
 void UIComponent::setPosition(sf::Vector2f position) {
     position_ = position;
 
     // Update render update flag
-    needRenderUpdate_ = true;
+    requestRenderUpdate();
 }
 
 void UIComponent::updatePosition(sf::Vector2f offset) {
     position_ += offset;
 
     // Update render update flag
-    needRenderUpdate_ = true;
+    requestRenderUpdate();
 }
 
 void UIComponent::setCallback(std::function<void()> callback) {
-    callback_ = std::move(callback);
+    if (callback) {
+        setCallback(CallbackType::Click, [callback = std::move(callback)](const sf::Event&) { callback(); });
+    } else {
+        setCallback(CallbackType::Click, nullptr);
+    }
+}
+
+void UIComponent::setCallback(CallbackType type, std::function<void(const sf::Event &)> callback) {
+    // Allocate the callback table with the first callback
+    if (callback and !callbacks_) {
+        callbacks_ = std::make_unique<CallbackTable>();
+    }
+    if (callbacks_) {
+        (*callbacks_)[static_cast<size_t>(type)] = std::move(callback);
+    }
+
+    // Update the mask and let the parent containers update theirs
+    if (callbacks_ and (*callbacks_)[static_cast<size_t>(type)]) {
+        callbackMask_ |= toCallbackMask(type);
+    } else {
+        callbackMask_ &= ~toCallbackMask(type);
+    }
+    if (parent_) {
+        parent_->updateCallbackMask();
+    }
+}
+
+bool UIComponent::invokeCallback(CallbackType type, const sf::Event &event) {
+    if (!callbacks_ or !(*callbacks_)[static_cast<size_t>(type)]) {
+        return false;
+    }
+
+    (*callbacks_)[static_cast<size_t>(type)](event);
+    return true;
+}
+
+void UIComponent::addHandledCallbackTypes(unsigned callbackMask) {
+    handledCallbackMask_ |= callbackMask;
+    if (parent_) {
+        parent_->updateCallbackMask();
+    }
+}
+
+unsigned UIComponent::getCallbackMask() const {
+    return callbackMask_ | handledCallbackMask_;
+}
+
+void UIComponent::setFocusable(bool focusable) {
+    if (focusable == isFocusable()) {
+        return;
+    }
+
+    // Update the chain of the tree the component is nested in, if it has one. The mask has to include the component
+    // while it is linked, so that the focus manager finds it
+    FocusManager* focusManager = parent_ ? parent_->getFocusManager() : nullptr;
+    if (focusManager and not focusable) {
+        focusManager->removeFocusable(*this);
+    }
+
+    callbackMask_ = focusable ? callbackMask_ | focusableMask : callbackMask_ & ~focusableMask;
+    if (parent_) {
+        parent_->updateCallbackMask();
+    }
+
+    if (focusManager and focusable) {
+        focusManager->addFocusable(*this);
+    }
+}
+
+bool UIComponent::isFocusable() const {
+    return callbackMask_ & focusableMask;
+}
+
+bool UIComponent::isFocused() const {
+    FocusManager* focusManager = parent_ ? parent_->getFocusManager() : nullptr;
+    return focusManager and focusManager->getFocus() == handle_;
+}
+
+void UIComponent::onFocusChanged(bool) {
+    requestRenderUpdate();
+}
+
+bool UIComponent::isHovered() const {
+    return isHovered_;
+}
+
+bool UIComponent::isPressed() const {
+    return isPressed_;
+}
+
+void UIComponent::onHoverChanged(bool) {
+    requestRenderUpdate();
+}
+
+void UIComponent::onPressedChanged(bool) {
+    requestRenderUpdate();
+}
+
+void UIComponent::updateLayout() {
+    if (needRenderUpdate_) {
+        updateRenderInformation();
+    }
+}
+
+void UIComponent::collectMemoryUsage(MemoryReport &report) const {
+    report.uiComponentCount++;
+    report.uiComponentBytes += sizeof(UIComponent) + getHeapBytes(name_);
+    if (callbacks_) {
+        report.uiComponentBytes += sizeof(CallbackTable);
+    }
+}
+
+void UIComponent::setParent(Container *parent) {
+    parent_ = parent;
+}
+
+void UIComponent::requestRenderUpdate() {
+    needRenderUpdate_ = true;
+
+    // The cached layers of the parent containers contain this component
+    if (parent_) {
+        parent_->invalidateLayers();
+    }
 }
 
 bool UIComponent::isVisible() const {
@@ -71,6 +213,10 @@ bool UIComponent::isEnabled() const {
     return isEnabled_;
 }
 
+UIComponentHandle UIComponent::getHandle() const {
+    return handle_;
+}
+
 const std::string &UIComponent::getName() const {
     return name_;
 }
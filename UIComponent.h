@@ -5,11 +5,37 @@
 #ifndef SWIFTIFYSFML_V0_1_UICOMPONENT_H
 #define SWIFTIFYSFML_V0_1_UICOMPONENT_H
 
+#include <array>
+#include <functional>
+#include <memory>
+#include "Enumerations.h"
+#include "SlotMap.h"
+#include "MemoryReport.h"
+
+// Forward declaration of the container, focus manager and pointer tracker classes
+class Container;
+class FocusManager;
+class PointerTracker;
+
+// Stable handle to a UI component
+class UIComponent;
+using UIComponentHandle = Handle<UIComponent>;
+
+// Callback functions of an element, indexed by callback type
+using CallbackTable = std::array<std::function<void(const sf::Event&)>, callbackTypeCount>;
+
 class UIComponent {
 public:
     // Constructor and destructor
     UIComponent(std::string name, const sf::Vector2f& sizeProportions);
-    virtual ~UIComponent() = default;
+    virtual ~UIComponent();
+
+    // Delete copy constructor and copy assignment operator. Each UI component has its own handle
+    UIComponent(const UIComponent&) = delete;
+    UIComponent& operator=(const UIComponent&) = delete;
+
+    // Get the UI component a handle refers to. Returns nullptr if it doesn't exist anymore
+    static UIComponent* resolve(UIComponentHandle handle);
 
     // Setter functions
 
@@ -17,7 +43,16 @@ public:
     void setVisible(bool visible);
     void setEnabled(bool enabled);
 
+    // Set a callback for a type of event. The callback without an event parameter is registered as click callback
     void setCallback(std::function<void()> callback);
+    void setCallback(CallbackType type, std::function<void(const sf::Event&)> callback);
+
+    // Set the container the UI component is nested in. Called by the container when the component is added
+    void setParent(Container* parent);
+
+    // Let the UI component receive the keyboard focus. Focusable components are part of the focus chain of the
+    // screen they are shown on
+    void setFocusable(bool focusable);
 
     // Layout-related properties
     void setParentSize(sf::Vector2f parentSize);
@@ -32,15 +67,29 @@ public:
     [[nodiscard]] bool isVisible() const;
     [[nodiscard]] bool isEnabled() const;
 
+    // Get the callback types the UI component reacts to. Used by the parent containers to skip it during dispatch
+    [[nodiscard]] unsigned getCallbackMask() const;
+
+    // Get the focus flags. Checking the focus walks up to the root container
+    [[nodiscard]] bool isFocusable() const;
+    [[nodiscard]] bool isFocused() const;
+
+    // Get the pointer flags. Set by the pointer tracker while the cursor is over the component or the component is
+    // pressed
+    [[nodiscard]] bool isHovered() const;
+    [[nodiscard]] bool isPressed() const;
+
     // Get internal properties, only as const references
+    [[nodiscard]] UIComponentHandle getHandle() const;
     [[nodiscard]] const std::string& getName() const;
     [[nodiscard]] const sf::Vector2f& getPosition() const;
     [[nodiscard]] const sf::Vector2f& getSize() const;
 
     // UI-related functions
 
-    // Draws the UI component to the screen according to the render information
-    virtual void draw(sf::RenderWindow& window) = 0;
+    // Draws the UI component to the screen according to the render information. The render states carry the animated
+    // transforms of the parent containers
+    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) = 0;
 
     // Handle events such as mouse clicks or key presses
     virtual bool handleEvent(const sf::Event& event) = 0;
@@ -48,14 +97,65 @@ public:
     // Update the render information for the UI component
     virtual void updateRenderInformation() = 0;
 
+    // Update the render information only if it is outdated. Used to compute the layout ahead of drawing
+    void updateLayout();
+
+    // Add the memory used by the UI component to the report. Subclasses with own members or assets override this,
+    // add the size beyond the base class and their heap memory, and call the base implementation
+    virtual void collectMemoryUsage(MemoryReport& report) const;
+
 protected:
+    // The focus manager links the component into the focus chain and notifies it about focus changes. The pointer
+    // tracker notifies it about hover and press changes
+    friend class FocusManager;
+    friend class PointerTracker;
+
+    // The container keeps the index of the component in its elements up to date
+    friend class Container;
+
+    // Registry of all UI components, used to resolve handles
+    static SlotMap<UIComponent>& getRegistry();
+
+    // Called when the component gains or loses the keyboard focus. Requests a render update by default, so that
+    // subclasses can draw a focus indicator
+    virtual void onFocusChanged(bool focused);
+
+    // Called when the cursor enters or leaves the component, and when the component is pressed or released. Request a
+    // render update by default, so that subclasses can draw hover and pressed effects. Other components aren't
+    // affected
+    virtual void onHoverChanged(bool hovered);
+    virtual void onPressedChanged(bool pressed);
+
+    // Set the render update flag and invalidate the cached layers of the parent containers. Subclasses should use this
+    // instead of setting the flag directly.
+    void requestRenderUpdate();
+
+    // Execute the callback of the given type, if one is set. Returns true if a callback has been executed. Meant to be
+    // used in the handleEvent implementation of subclasses.
+    bool invokeCallback(CallbackType type, const sf::Event& event);
+
+    // Add callback types the UI component reacts to without a callback being set, e.g., for internal behavior of
+    // subclasses. Events of other types aren't passed to the component's handleEvent function.
+    void addHandledCallbackTypes(unsigned callbackMask);
+
     // Flag indicating if the render information needs to be updated. Only set internally.
     bool needRenderUpdate_;
 
+    // Container the UI component is nested in and the index in its elements. Not owned
+    Container* parent_ = nullptr;
+    size_t indexInParent_ = 0;
+
+    // Stable handle to this UI component. Registered in the constructor and removed in the destructor
+    UIComponentHandle handle_;
+
     // Flags indicating visibility and responsiveness
     bool isVisible_;
     bool isEnabled_;
 
+    // Flags indicating if the cursor is over the component and if it is pressed. Only set by the pointer tracker
+    bool isHovered_ = false;
+    bool isPressed_ = false;
+
     // Name for identification. Probably only used in events and interactions. Set in the constructor and can only be
     // gotten afterward.
     std::string name_;
@@ -73,8 +173,14 @@ protected:
     // gotten and not set.
     sf::Vector2f size_;
 
-    // Stores the callback function that should be executed when an event is recognized.
-    std::function<void()> callback_;
+    // Stores the callback functions that should be executed when an event is recognized. Only allocated once a
+    // callback is set, since most elements don't have any
+    std::unique_ptr<CallbackTable> callbacks_ = nullptr;
+
+    // Callback types the UI component reacts to. Combines the set callbacks, the focusable flag and the added
+    // handled types
+    unsigned callbackMask_ = 0;
+    unsigned handledCallbackMask_ = 0;
 };
 
 #endif //SWIFTIFYSFML_V0_1_UICOMPONENT_H
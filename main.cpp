@@ -6,12 +6,15 @@
 
 int main() {
     sf::RenderWindow window(sf::VideoMode(800, 600), "UI Demo");
-    // Set the frame rate limit to x FPS
-    window.setFramerateLimit(10);
+    // Synchronize with the display. Animations are paced individually and idle screens aren't redrawn
+    window.setVerticalSyncEnabled(true);
 
     // Ensure that the Application is created as a shared_ptr
     auto myApp = std::make_shared<Application>(window);
 
+    // The frame pacer can't query vertical synchronization, so it has to be told. It then leaves pacing to the display
+    myApp->getFramePacer().setVerticalSyncEnabled(true);
+
     // Create a screen and set a background color
     Screen myScreen("StartScreen", window);
     myScreen.setBackground(sf::Color::Blue);